@@ -0,0 +1,49 @@
+#ifndef NOP_CSV_CHECKPOINT_HPP   /* Begin checkpoint header file */
+#define NOP_CSV_CHECKPOINT_HPP 1
+
+#include <cstdint>
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Resumable parser position
+     *
+     * @struct Checkpoint
+     *
+     * offset is the byte offset of the next row to parse, row its row number
+     * and inQuote the escape state at that offset. Everything before offset
+     * has already been handed to the caller.
+     */
+    struct Checkpoint
+    {
+    public:
+      uint64_t offset;
+      uint64_t row;
+      bool inQuote;
+
+    public:
+      /**
+       * @brief Reads a checkpoint file
+       *
+       * @throws invalid_argument if the file cannot be opened
+       * @throws format_error if the file is not a checkpoint
+       */
+      [[nodiscard]] static Checkpoint load(const char*);
+
+      /**
+       * @brief Writes a checkpoint file atomically (temporary file + rename)
+       *
+       * @throws system_error
+       */
+      void save(const char*) const;
+    };
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End checkpoint header file */
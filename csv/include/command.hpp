@@ -2,7 +2,9 @@
 #define __CSV_PARSER_COMMAND_HPP__ 1
 
 #include <utility>
+#include <string>
 #include <string_view>
+#include <vector>
 #include <cinttypes>
 
 namespace csv /* Begin namespace csv */
@@ -14,7 +16,22 @@ namespace csv /* Begin namespace csv */
     class DataHandler
     {
     private:
-      std::pair<std::string_view, size_t> m_data;
+      std::vector<std::string> m_files;
+      size_t m_skipLines;
+      bool m_directory;
+      size_t m_threads;
+      size_t m_chunkSize;
+      bool m_follow;
+      std::string_view m_checkpoint;
+      size_t m_checkpointInterval;
+      size_t m_sortColumn;
+      size_t m_memory;
+      std::string_view m_tempDir;
+      std::string_view m_joinFile;
+      size_t m_joinColumn;
+      bool m_profile;
+      bool m_infer;
+      size_t m_sample;
 
     public:
       DataHandler(int32_t, char**);
@@ -24,6 +41,22 @@ namespace csv /* Begin namespace csv */
 
       [[nodiscard]] size_t getSkipLines() const noexcept;
       [[nodiscard]] const char* getFileName() const noexcept;
+      [[nodiscard]] const std::vector<std::string>& getFiles() const noexcept;
+      [[nodiscard]] bool isMultiFile() const noexcept;
+      [[nodiscard]] size_t getChunkSize() const noexcept;
+      [[nodiscard]] bool isStdin() const noexcept;
+      [[nodiscard]] size_t getThreads() const noexcept;
+      [[nodiscard]] bool isFollow() const noexcept;
+      [[nodiscard]] const char* getCheckpoint() const noexcept;
+      [[nodiscard]] size_t getCheckpointInterval() const noexcept;
+      [[nodiscard]] size_t getSortColumn() const noexcept;
+      [[nodiscard]] size_t getMemory() const noexcept;
+      [[nodiscard]] const char* getTempDir() const noexcept;
+      [[nodiscard]] const char* getJoinFile() const noexcept;
+      [[nodiscard]] size_t getJoinColumn() const noexcept;
+      [[nodiscard]] bool isProfile() const noexcept;
+      [[nodiscard]] bool isInfer() const noexcept;
+      [[nodiscard]] size_t getSample() const noexcept;
 
       DataHandler& operator=(const DataHandler&) = default;
       DataHandler& operator=(DataHandler&&) = default;
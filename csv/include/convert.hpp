@@ -0,0 +1,535 @@
+#ifndef NOP_CSV_CONVERT_HPP   /* Begin convert header file */
+#define NOP_CSV_CONVERT_HPP 1
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <compare>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <concepts>
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Conversion of one unescaped field into a typed value
+     *
+     * @struct FieldTraits
+     *
+     * @tparam T Column type
+     *
+     * Specializations provide `static bool parse(std::string_view, T&)` that
+     * returns false when the whole field is not a valid representation of T.
+     * The arithmetic and bool ones are constexpr, so they also serve the
+     * compile-time parser.
+     */
+    template<typename T>
+    struct FieldTraits;
+
+    /**
+     * @brief Unsigned integer of any size for exact compile-time float conversion
+     *
+     * @class ExactInteger
+     *
+     * Only the operations the decimal to binary conversion needs, 32-bit limbs
+     * stored least significant first with no zero limb on top.
+     */
+    class ExactInteger
+    {
+    private:
+      std::vector<uint32_t> m_limbs;
+
+    private:
+      constexpr void trim() noexcept
+      {
+        while (m_limbs.empty() == false && m_limbs.back() == 0U)
+          m_limbs.pop_back();
+      }
+
+    public:
+      constexpr ExactInteger() = default;
+
+      constexpr explicit ExactInteger(uint32_t value)
+      {
+        if (value != 0U)
+          m_limbs.push_back(value);
+      }
+
+      [[nodiscard]] constexpr bool isZero() const noexcept
+      {
+        return m_limbs.empty();
+      }
+
+      [[nodiscard]] constexpr size_t bitLength() const noexcept
+      {
+        if (m_limbs.empty() == true)
+          return 0UL;
+
+        size_t length{(m_limbs.size() - 1UL) * 32UL};
+
+        for (uint32_t top{m_limbs.back()}; top != 0U; top >>= 1)
+          ++length;
+
+        return length;
+      }
+
+      [[nodiscard]] constexpr bool bit(size_t index) const noexcept
+      {
+        return index / 32UL < m_limbs.size() && ((m_limbs[index / 32UL] >> (index % 32UL)) & 1U) == 1U;
+      }
+
+      /* Whether any bit below index is set */
+      [[nodiscard]] constexpr bool anyBelow(size_t index) const noexcept
+      {
+        for (size_t limb{}; limb < m_limbs.size() && limb * 32UL < index; ++limb)
+        {
+          uint32_t mask{index - limb * 32UL >= 32UL ? ~0U : (1U << (index - limb * 32UL)) - 1U};
+
+          if ((m_limbs[limb] & mask) != 0U)
+            return true;
+        }
+
+        return false;
+      }
+
+      /* *this = *this * factor + addend */
+      constexpr void multiplyAdd(uint32_t factor, uint32_t addend)
+      {
+        uint64_t carry{addend};
+
+        for (auto& limb : m_limbs)
+        {
+          carry += static_cast<uint64_t>(limb) * factor;
+          limb = static_cast<uint32_t>(carry);
+          carry >>= 32;
+        }
+
+        if (carry != 0UL)
+          m_limbs.push_back(static_cast<uint32_t>(carry));
+
+        trim();
+      }
+
+      constexpr void multiplyPow10(uint64_t exponent)
+      {
+        for (; exponent >= 9UL; exponent -= 9UL)
+          multiplyAdd(1000000000U, 0U);
+
+        for (; exponent > 0UL; --exponent)
+          multiplyAdd(10U, 0U);
+      }
+
+      constexpr void shiftLeft(size_t bits)
+      {
+        if (m_limbs.empty() == true)
+          return;
+
+        m_limbs.insert(m_limbs.begin(), bits / 32UL, 0U);
+
+        if (bits % 32UL != 0UL)
+        {
+          uint32_t carry{};
+
+          for (auto& limb : m_limbs)
+          {
+            uint32_t next{limb >> (32UL - bits % 32UL)};
+            limb = (limb << (bits % 32UL)) | carry;
+            carry = next;
+          }
+
+          if (carry != 0U)
+            m_limbs.push_back(carry);
+        }
+      }
+
+      constexpr void shiftRight(size_t bits)
+      {
+        if (bits / 32UL >= m_limbs.size())
+        {
+          m_limbs.clear();
+          return;
+        }
+
+        m_limbs.erase(m_limbs.begin(), m_limbs.begin() + static_cast<std::ptrdiff_t>(bits / 32UL));
+
+        if (bits % 32UL != 0UL)
+        {
+          for (size_t limb{}; limb != m_limbs.size(); ++limb)
+          {
+            uint32_t high{limb + 1UL < m_limbs.size() ? m_limbs[limb + 1UL] << (32UL - bits % 32UL) : 0U};
+            m_limbs[limb] = (m_limbs[limb] >> (bits % 32UL)) | high;
+          }
+        }
+
+        trim();
+      }
+
+      /* *this -= other, other must not be larger */
+      constexpr void subtract(const ExactInteger& other) noexcept
+      {
+        int64_t borrow{};
+
+        for (size_t limb{}; limb != m_limbs.size(); ++limb)
+        {
+          int64_t difference{static_cast<int64_t>(m_limbs[limb]) - borrow -
+                             (limb < other.m_limbs.size() ? static_cast<int64_t>(other.m_limbs[limb]) : 0L)};
+          borrow = difference < 0L ? 1L : 0L;
+          m_limbs[limb] = static_cast<uint32_t>(difference + (borrow << 32));
+        }
+
+        trim();
+      }
+
+      /* Replaces *this with the remainder and returns the quotient */
+      [[nodiscard]] constexpr ExactInteger divide(const ExactInteger& divisor)
+      {
+        ExactInteger quotient;
+
+        if (bitLength() < divisor.bitLength())
+          return quotient;
+
+        for (size_t shift{bitLength() - divisor.bitLength() + 1UL}; shift-- > 0UL;)
+        {
+          ExactInteger shifted{divisor};
+          shifted.shiftLeft(shift);
+          quotient.shiftLeft(1UL);
+
+          if (shifted <= *this)
+          {
+            subtract(shifted);
+            quotient.multiplyAdd(1U, 1U);
+          }
+        }
+
+        return quotient;
+      }
+
+      /* Exact as long as the value fits the mantissa of T */
+      template<typename T>
+      [[nodiscard]] constexpr T toFloating() const noexcept
+      {
+        T value{};
+
+        for (size_t limb{m_limbs.size()}; limb-- > 0UL;)
+          value = value * T{4294967296.0} + static_cast<T>(m_limbs[limb]);
+
+        return value;
+      }
+
+      [[nodiscard]] friend constexpr std::strong_ordering operator<=>(const ExactInteger& lhs, const ExactInteger& rhs) noexcept
+      {
+        if (lhs.m_limbs.size() != rhs.m_limbs.size())
+          return lhs.m_limbs.size() <=> rhs.m_limbs.size();
+
+        for (size_t limb{lhs.m_limbs.size()}; limb-- > 0UL;)
+          if (lhs.m_limbs[limb] != rhs.m_limbs[limb])
+            return lhs.m_limbs[limb] <=> rhs.m_limbs[limb];
+
+        return std::strong_ordering::equal;
+      }
+
+      [[nodiscard]] friend constexpr bool operator==(const ExactInteger&, const ExactInteger&) noexcept = default;
+    };
+
+    template<typename T>
+    requires (std::is_arithmetic_v<T> == true && std::is_same_v<T, bool> == false)
+    struct FieldTraits<T>
+    {
+    private:
+      /* std::from_chars is not constexpr in every standard library, constant evaluation takes these */
+      [[nodiscard]] static constexpr bool parseInteger(std::string_view field, T& value) noexcept
+      {
+        bool negative{std::is_signed_v<T> == true && field.starts_with('-') == true};
+        std::string_view digits{field.substr(negative == true ? 1UL : 0UL)};
+        std::make_unsigned_t<T> limit{static_cast<std::make_unsigned_t<T>>(
+            static_cast<std::make_unsigned_t<T>>(std::numeric_limits<T>::max()) + (negative == true ? 1U : 0U))};
+        std::make_unsigned_t<T> result{};
+
+        if (digits.empty() == true)
+          return false;
+
+        for (const auto& symbol : digits)
+        {
+          if (symbol < '0' || symbol > '9' || result > (limit - static_cast<unsigned>(symbol - '0')) / 10U)
+            return false;
+
+          result = static_cast<std::make_unsigned_t<T>>(result * 10U + static_cast<unsigned>(symbol - '0'));
+        }
+
+        value = negative == true ? static_cast<T>(0U - result) : static_cast<T>(result);
+        return true;
+      }
+
+      /* Case-insensitive match of the inf and nan spellings std::from_chars accepts */
+      [[nodiscard]] static constexpr bool matches(std::string_view field, std::string_view word) noexcept
+      {
+        if (field.size() != word.size())
+          return false;
+
+        for (size_t i{}; i != word.size(); ++i)
+          if (field[i] != word[i] && field[i] != word[i] - 'a' + 'A')
+            return false;
+
+        return true;
+      }
+
+      /*
+       * Same result as std::from_chars: the decimal value is converted exactly
+       * (ExactInteger) and rounded once to nearest, ties to even. Fields that
+       * overflow, or round to zero although they are not zero, are rejected.
+       */
+      [[nodiscard]] static constexpr bool parseFloating(std::string_view field, T& value) noexcept
+      {
+        constexpr int64_t precision{std::numeric_limits<T>::digits};
+        constexpr int64_t minExponent{std::numeric_limits<T>::min_exponent - 1};
+        constexpr int64_t maxExponent{std::numeric_limits<T>::max_exponent - 1};
+        /* No halfway point between two values of T has more significant digits */
+        constexpr size_t maxDigits{static_cast<size_t>(precision - minExponent + 2)};
+
+        bool negative{field.starts_with('-') == true};
+        std::string_view text{field.substr(negative == true ? 1UL : 0UL)};
+
+        if (matches(text, "inf") == true || matches(text, "infinity") == true)
+        {
+          value = negative == true ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+          return true;
+        }
+
+        if (matches(text, "nan") == true ||
+            (text.size() > 4UL && matches(text.substr(0UL, 4UL), "nan(") == true && text.back() == ')' &&
+             text.substr(4UL, text.size() - 5UL).find_first_not_of(
+               "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_") == std::string_view::npos))
+        {
+          value = negative == true ? -std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::quiet_NaN();
+          return true;
+        }
+
+        size_t position{};
+        ExactInteger mantissa;
+        int64_t exponent{};
+        size_t digits{};
+        size_t significant{};
+        bool sticky{false};
+
+        auto digit{[&text, &position]
+        {
+          return position < text.size() && text[position] >= '0' && text[position] <= '9';
+        }};
+
+        auto append{[&](bool fraction)
+        {
+          uint32_t symbol{static_cast<uint32_t>(text[position] - '0')};
+          ++digits;
+
+          if (significant == 0UL && symbol == 0U)
+            exponent -= fraction == true ? 1L : 0L;
+          else if (significant < maxDigits)
+          {
+            mantissa.multiplyAdd(10U, symbol);
+            ++significant;
+            exponent -= fraction == true ? 1L : 0L;
+          }
+          else
+          {
+            exponent += fraction == true ? 0L : 1L;
+            sticky = sticky == true || symbol != 0U;
+          }
+        }};
+
+        for (; digit() == true; ++position)
+          append(false);
+
+        if (position < text.size() && text[position] == '.')
+          for (++position; digit() == true; ++position)
+            append(true);
+
+        if (digits == 0UL)
+          return false;
+
+        if (position < text.size() && (text[position] == 'e' || text[position] == 'E'))
+        {
+          ++position;
+          bool negativeExponent{position < text.size() && text[position] == '-'};
+
+          if (position < text.size() && (text[position] == '-' || text[position] == '+'))
+            ++position;
+
+          if (digit() == false)
+            return false;
+
+          int64_t written{};
+
+          for (; digit() == true; ++position)
+            written = written < 100000L ? written * 10L + (text[position] - '0') : written;
+
+          exponent += negativeExponent == true ? -written : written;
+        }
+
+        if (position != text.size())
+          return false;
+
+        if (mantissa.isZero() == true)
+        {
+          value = negative == true ? -T{} : T{};
+          return true;
+        }
+
+        /* Digits cut off past maxDigits only decide the rounding direction */
+        if (sticky == true)
+        {
+          mantissa.multiplyAdd(10U, 1U);
+          ++significant;
+          --exponent;
+        }
+
+        /* The field lies in [10^(significant - 1 + exponent), 10^(significant + exponent)) */
+        if (static_cast<int64_t>(significant) - 1L + exponent > std::numeric_limits<T>::max_exponent10 ||
+            static_cast<int64_t>(significant) + exponent < static_cast<int64_t>(static_cast<double>(minExponent + 1L - precision) * 0.30103) - 2L)
+          return false;
+
+        /* value = (mantissa + fraction) * 2^binary, sticky tells whether the fraction is nonzero */
+        int64_t binary{};
+        sticky = false;
+
+        if (exponent >= 0L)
+          mantissa.multiplyPow10(static_cast<uint64_t>(exponent));
+        else
+        {
+          ExactInteger divisor{1U};
+          divisor.multiplyPow10(static_cast<uint64_t>(-exponent));
+
+          /* Enough quotient bits for the mantissa, the rounding bit and one to spare */
+          int64_t shift{precision + 2L + static_cast<int64_t>(divisor.bitLength()) - static_cast<int64_t>(mantissa.bitLength())};
+
+          if (shift > 0L)
+          {
+            mantissa.shiftLeft(static_cast<size_t>(shift));
+            binary = -shift;
+          }
+
+          ExactInteger quotient{mantissa.divide(divisor)};
+          sticky = mantissa.isZero() == false;
+          mantissa = std::move(quotient);
+        }
+
+        int64_t length{static_cast<int64_t>(mantissa.bitLength())};
+        int64_t lead{binary + length - 1L};
+        /* Subnormal results keep fewer bits */
+        int64_t bits{lead >= minExponent ? precision : precision - (minExponent - lead)};
+
+        if (int64_t shift{length - bits}; shift > 0L)
+        {
+          bool half{mantissa.bit(static_cast<size_t>(shift - 1L))};
+          bool below{sticky == true || mantissa.anyBelow(static_cast<size_t>(shift - 1L))};
+          mantissa.shiftRight(static_cast<size_t>(shift));
+
+          if (half == true && (below == true || mantissa.bit(0UL) == true))
+            mantissa.multiplyAdd(1U, 1U);
+
+          binary += shift;
+        }
+
+        if (mantissa.isZero() == true || binary + static_cast<int64_t>(mantissa.bitLength()) - 1L > maxExponent)
+          return false;
+
+        /* 2^binary, squaring stops at the last exponent bit so it never leaves the range of T */
+        T scale{1};
+        T base{binary < 0L ? T{0.5} : T{2}};
+
+        for (uint64_t rest{static_cast<uint64_t>(binary < 0L ? -binary : binary)}; rest != 0UL;)
+        {
+          if ((rest & 1UL) == 1UL)
+            scale *= base;
+
+          rest >>= 1;
+
+          if (rest != 0UL)
+            base *= base;
+        }
+
+        T result{mantissa.toFloating<T>() * scale};
+        value = negative == true ? -result : result;
+        return true;
+      }
+
+    public:
+      [[nodiscard]] static constexpr bool parse(std::string_view field, T& value) noexcept
+      {
+        if consteval
+        {
+          if constexpr (std::is_integral_v<T> == true)
+            return parseInteger(field, value);
+          else
+            return parseFloating(field, value);
+        }
+        else
+        {
+          const char* end{field.data() + field.size()};
+          auto [ptr, code]{std::from_chars(field.data(), end, value)};
+          return code == std::errc{} && ptr == end;
+        }
+      }
+    };
+
+    template<>
+    struct FieldTraits<bool>
+    {
+    public:
+      [[nodiscard]] static constexpr bool parse(std::string_view field, bool& value) noexcept
+      {
+        if (field == "1" || field == "true")
+          value = true;
+        else if (field == "0" || field == "false")
+          value = false;
+        else
+          return false;
+
+        return true;
+      }
+    };
+
+    template<>
+    struct FieldTraits<std::string>
+    {
+    public:
+      [[nodiscard]] static bool parse(std::string_view field, std::string& value)
+      {
+        value.assign(field);
+        return true;
+      }
+    };
+
+    /**
+     * @brief Field referring to the parsed text itself
+     *
+     * Only valid as long as that text lives: static data, or a caller owned
+     * buffer. The streaming parsers reuse their buffers for every row.
+     */
+    template<>
+    struct FieldTraits<std::string_view>
+    {
+    public:
+      [[nodiscard]] static constexpr bool parse(std::string_view field, std::string_view& value) noexcept
+      {
+        value = field;
+        return true;
+      }
+    };
+
+    template<typename T>
+    concept ConvertibleField = requires(std::string_view field, T& value)
+    {
+      { FieldTraits<T>::parse(field, value) } -> std::same_as<bool>;
+    };
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End convert header file */
@@ -0,0 +1,319 @@
+#ifndef NOP_CSV_DATETIME_HPP   /* Begin datetime header file */
+#define NOP_CSV_DATETIME_HPP 1
+
+#include <chrono>
+#include <string_view>
+#include <compare>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include "convert.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief ISO-8601 calendar date column (YYYY-MM-DD)
+     *
+     * @struct Date
+     */
+    struct Date
+    {
+    public:
+      std::chrono::sys_days value;
+
+    public:
+      /**
+       * @brief Days since 1970-01-01
+       */
+      [[nodiscard]] constexpr int64_t epoch() const noexcept
+      {
+        return value.time_since_epoch().count();
+      }
+
+      [[nodiscard]] constexpr auto operator<=>(const Date&) const noexcept = default;
+    };
+
+    /**
+     * @brief ISO-8601 timestamp column
+     *
+     * @struct BasicTimestamp
+     *
+     * @tparam Duration Precision of the stored time point, longer fractions are truncated
+     *
+     * Accepts YYYY-MM-DD(T| )HH:MM:SS, an optional fraction of up to nine
+     * digits and an optional Z or (+|-)HH:MM offset; the stored value is UTC.
+     */
+    template<class Duration>
+    struct BasicTimestamp
+    {
+    public:
+      std::chrono::sys_time<Duration> value;
+
+    public:
+      /**
+       * @brief Duration ticks since 1970-01-01T00:00:00Z
+       */
+      [[nodiscard]] constexpr int64_t epoch() const noexcept
+      {
+        return static_cast<int64_t>(value.time_since_epoch().count());
+      }
+
+      [[nodiscard]] constexpr auto operator<=>(const BasicTimestamp&) const noexcept = default;
+    };
+
+    using Timestamp = BasicTimestamp<std::chrono::milliseconds>;
+
+    /**
+     * @brief Branch-free digit extraction for fixed layout date/time fields
+     *
+     * Eight field bytes are loaded into one little-endian word: the separator
+     * bytes are compared under a mask, the digit bytes are range checked all at
+     * once and every pair of adjacent digits is combined with one multiply and
+     * shift, so a full timestamp costs three words and no per-digit branches.
+     */
+    class DateTimeDigits
+    {
+    public:
+      static constexpr size_t DateSize{10UL};
+      static constexpr size_t TimeSize{19UL};
+
+    private:
+      static constexpr uint64_t Zeros{0x3030303030303030UL};
+
+      /* Bytes 0-7 "YYYY-MM-", 8-15 "DD?HH:MM" (? is checked separately), 16-23 ":SS" */
+      static constexpr uint64_t DateSeparators{0xFF0000FF00000000UL};
+      static constexpr uint64_t DateSeparatorValues{0x2D00002D00000000UL};
+      static constexpr uint64_t TimeSeparators{0x0000FF0000000000UL};
+      static constexpr uint64_t TimeSeparatorValues{0x00003A0000000000UL};
+      static constexpr uint64_t SecondSeparators{0x00000000000000FFUL};
+      static constexpr uint64_t SecondSeparatorValues{0x000000000000003AUL};
+
+    private:
+      uint64_t m_words[3];
+      bool m_valid;
+
+    private:
+      /* Separator bytes must match, the others must be '0'-'9'; returns the digit pairs */
+      [[nodiscard]] static constexpr uint64_t pairs(uint64_t word, uint64_t separators, uint64_t values, uint64_t digits, bool& valid) noexcept
+      {
+        uint64_t masked{(word & digits) | (Zeros & ~digits)};
+
+        valid = valid && (word & separators) == values
+                      && (masked & 0xF0F0F0F0F0F0F0F0UL) == Zeros
+                      && ((masked + 0x0606060606060606UL) & 0xF0F0F0F0F0F0F0F0UL) == Zeros;
+
+        uint64_t value{masked - Zeros};
+
+        /* Byte i becomes 10 * digit(i) + digit(i + 1), never more than 99 */
+        return value * 10UL + (value >> 8U);
+      }
+
+      [[nodiscard]] static constexpr uint32_t byte(uint64_t word, uint32_t index) noexcept
+      {
+        return static_cast<uint32_t>((word >> (index * 8U)) & 0xFFU);
+      }
+
+    public:
+      /**
+       * @brief Loads and checks the first DateSize or TimeSize bytes of text
+       *
+       * @param [in] text Field, bytes past its end are never read
+       * @param [in] time Whether the time of day part is present
+       */
+      DateTimeDigits(std::string_view text, bool time) noexcept
+        : m_words{}
+        , m_valid{text.size() >= (time == true ? TimeSize : DateSize)}
+      {
+        char buffer[24]{};
+        std::memcpy(buffer, text.data(), std::min(text.size(), sizeof(buffer)));
+
+        uint64_t words[3];
+        std::memcpy(words, buffer, sizeof(words));
+
+        /* Bytes past the used part are not checked as digits */
+        uint64_t dateDigits{~DateSeparators};
+        uint64_t dayDigits{time == true ? ~(TimeSeparators | 0x0000000000FF0000UL) : 0x000000000000FFFFUL};
+        uint64_t secondDigits{time == true ? 0x0000000000FFFF00UL : 0UL};
+
+        m_words[0] = pairs(words[0], DateSeparators, DateSeparatorValues, dateDigits, m_valid);
+        m_words[1] = pairs(words[1], time == true ? TimeSeparators : 0UL, time == true ? TimeSeparatorValues : 0UL, dayDigits, m_valid);
+        m_words[2] = pairs(words[2], time == true ? SecondSeparators : 0UL, time == true ? SecondSeparatorValues : 0UL, secondDigits, m_valid);
+
+        if (time == true)
+          m_valid = m_valid && (buffer[10] == 'T' || buffer[10] == ' ');
+      }
+
+      [[nodiscard]] bool valid() const noexcept
+      {
+        return m_valid;
+      }
+
+      [[nodiscard]] int32_t year() const noexcept
+      {
+        return static_cast<int32_t>(byte(m_words[0], 0U) * 100U + byte(m_words[0], 2U));
+      }
+
+      [[nodiscard]] uint32_t month() const noexcept
+      {
+        return byte(m_words[0], 5U);
+      }
+
+      [[nodiscard]] uint32_t day() const noexcept
+      {
+        return byte(m_words[1], 0U);
+      }
+
+      [[nodiscard]] uint32_t hour() const noexcept
+      {
+        return byte(m_words[1], 3U);
+      }
+
+      [[nodiscard]] uint32_t minute() const noexcept
+      {
+        return byte(m_words[1], 6U);
+      }
+
+      [[nodiscard]] uint32_t second() const noexcept
+      {
+        return byte(m_words[2], 1U);
+      }
+    };
+
+    /**
+     * @brief Writes YYYY-MM-DD, returns the end of the written text
+     */
+    char* formatDate(char* out, std::chrono::sys_days) noexcept;
+
+    template<>
+    struct FieldTraits<Date>
+    {
+    public:
+      [[nodiscard]] static bool parse(std::string_view field, Date& value) noexcept
+      {
+        DateTimeDigits digits{field, false};
+        std::chrono::year_month_day date{std::chrono::year{digits.year()},
+                                         std::chrono::month{digits.month()},
+                                         std::chrono::day{digits.day()}};
+
+        if (field.size() != DateTimeDigits::DateSize || digits.valid() == false || date.ok() == false)
+          return false;
+
+        value.value = std::chrono::sys_days{date};
+        return true;
+      }
+
+      static char* format(char* out, [[maybe_unused]] char* end, const Date& value) noexcept
+      {
+        return formatDate(out, value.value);
+      }
+    };
+
+    template<class Duration>
+    struct FieldTraits<BasicTimestamp<Duration>>
+    {
+    public:
+      [[nodiscard]] static bool parse(std::string_view field, BasicTimestamp<Duration>& value) noexcept
+      {
+        DateTimeDigits digits{field, true};
+        std::chrono::year_month_day date{std::chrono::year{digits.year()},
+                                         std::chrono::month{digits.month()},
+                                         std::chrono::day{digits.day()}};
+
+        if (digits.valid() == false || date.ok() == false ||
+            digits.hour() > 23U || digits.minute() > 59U || digits.second() > 59U)
+          return false;
+
+        size_t position{DateTimeDigits::TimeSize};
+        int64_t nanoseconds{};
+
+        if (position < field.size() && field[position] == '.')
+        {
+          int64_t scale{100000000};
+          size_t first{++position};
+
+          for (; position < field.size() && field[position] >= '0' && field[position] <= '9'; ++position, scale /= 10)
+            nanoseconds += (field[position] - '0') * scale;
+
+          if (position == first || position - first > 9UL)
+            return false;
+        }
+
+        std::chrono::minutes offset{};
+
+        if (position < field.size() && field[position] == 'Z')
+          ++position;
+        else if (position < field.size() && (field[position] == '+' || field[position] == '-'))
+        {
+          std::string_view zone{field.substr(position)};
+
+          if (zone.size() != 6UL || zone[3] != ':' ||
+              (zone[1] < '0' || zone[1] > '9' || zone[2] < '0' || zone[2] > '9' || zone[4] < '0' || zone[4] > '5' || zone[5] < '0' || zone[5] > '9'))
+            return false;
+
+          /* Offset hours are bounded like the hours of the time itself */
+          int32_t hours{(zone[1] - '0') * 10 + (zone[2] - '0')};
+
+          if (hours > 23)
+            return false;
+
+          offset = std::chrono::hours{hours} + std::chrono::minutes{(zone[4] - '0') * 10 + (zone[5] - '0')};
+          offset = zone[0] == '-' ? -offset : offset;
+          position += zone.size();
+        }
+
+        if (position != field.size())
+          return false;
+
+        auto time{std::chrono::sys_days{date} +
+                  std::chrono::hours{digits.hour()} + std::chrono::minutes{digits.minute()} + std::chrono::seconds{digits.second()} +
+                  std::chrono::nanoseconds{nanoseconds} - offset};
+
+        value.value = std::chrono::floor<Duration>(time);
+        return true;
+      }
+
+      /* YYYY-MM-DDTHH:MM:SS, the fraction digits of Duration and Z */
+      static char* format(char* out, [[maybe_unused]] char* end, const BasicTimestamp<Duration>& value) noexcept
+      {
+        auto days{std::chrono::floor<std::chrono::days>(value.value)};
+        std::chrono::hh_mm_ss<Duration> time{value.value - days};
+
+        auto two{[&out](int64_t number)
+        {
+          *out++ = static_cast<char>('0' + number / 10);
+          *out++ = static_cast<char>('0' + number % 10);
+        }};
+
+        out = formatDate(out, days);
+        *out++ = 'T';
+        two(time.hours().count());
+        *out++ = ':';
+        two(time.minutes().count());
+        *out++ = ':';
+        two(time.seconds().count());
+
+        if constexpr (std::chrono::hh_mm_ss<Duration>::fractional_width > 0)
+        {
+          int64_t fraction{static_cast<int64_t>(time.subseconds().count())};
+          *out++ = '.';
+
+          for (int32_t i{std::chrono::hh_mm_ss<Duration>::fractional_width}; i-- > 0; fraction /= 10)
+            out[i] = static_cast<char>('0' + fraction % 10);
+
+          out += std::chrono::hh_mm_ss<Duration>::fractional_width;
+        }
+
+        *out++ = 'Z';
+        return out;
+      }
+    };
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End datetime header file */
@@ -0,0 +1,123 @@
+#ifndef NOP_CSV_DECOMPRESS_HPP   /* Begin decompress header file */
+#define NOP_CSV_DECOMPRESS_HPP 1
+
+#include <istream>
+#include <fstream>
+#include <streambuf>
+#include <string_view>
+#include <memory>
+#include <thread>
+#include <exception>
+#include "ring.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    enum class Codec : char
+    {
+      None,
+      Gzip,
+      Zstd
+    };
+
+    /**
+     * @brief Selects the codec from the file name suffix (.gz / .zst)
+     */
+    [[nodiscard]] Codec detectCodec(std::string_view fileName) noexcept;
+
+    /**
+     * @brief Stream buffer that decompresses a file on a background thread
+     *
+     * @class DecompressBuf
+     *
+     * The decoder thread fills fixed-size blocks and hands them to the reader
+     * through a bounded ring; consumed blocks travel back through a second ring,
+     * so no memory is allocated after construction and decoding overlaps parsing.
+     */
+    class DecompressBuf : public std::streambuf
+    {
+    public:
+      static constexpr size_t BlockSize{1UL << 18};
+      static constexpr size_t InputSize{1UL << 16};
+      static constexpr size_t RingBlocks{8UL};
+
+    private:
+      struct Block
+      {
+        std::unique_ptr<char[]> data;
+        size_t size;
+      };
+
+      using Ring = SpscRing<std::unique_ptr<Block>, RingBlocks>;
+
+    private:
+      std::ifstream m_file;
+      Codec m_codec;
+      Ring m_filled;
+      Ring m_free;
+      std::unique_ptr<Block> m_current;
+      std::exception_ptr m_error;
+      std::thread m_worker;
+
+    private:
+      void run() noexcept;
+      void inflateGzip();
+      void inflateZstd();
+      [[nodiscard]] bool acquireBlock(std::unique_ptr<Block>&);
+      [[nodiscard]] bool releaseBlock(std::unique_ptr<Block>&);
+
+    protected:
+      int_type underflow() override;
+
+    public:
+      DecompressBuf(const char*, Codec);
+      DecompressBuf(const DecompressBuf&) = delete;
+      DecompressBuf(DecompressBuf&&) = delete;
+      ~DecompressBuf() override;
+
+      [[nodiscard]] bool isOpen() const noexcept;
+
+      DecompressBuf& operator=(const DecompressBuf&) = delete;
+      DecompressBuf& operator=(DecompressBuf&&) = delete;
+    };
+
+    /**
+     * @brief Input stream over a gzip or zstd compressed file
+     *
+     * @class DecompressStream
+     *
+     * Decoder errors are rethrown from the reading call (badbit is in the
+     * exception mask), so a corrupt archive surfaces through Parser as is.
+     */
+    class DecompressStream : public std::istream
+    {
+    private:
+      DecompressBuf m_buffer;
+
+    public:
+      DecompressStream(const char*, Codec);
+      DecompressStream(const DecompressStream&) = delete;
+      DecompressStream(DecompressStream&&) = delete;
+      ~DecompressStream() override = default;
+
+      DecompressStream& operator=(const DecompressStream&) = delete;
+      DecompressStream& operator=(DecompressStream&&) = delete;
+    };
+
+    /**
+     * @brief Opens a plain or compressed csv file depending on its suffix
+     *
+     * @param [in] fileName Path to .csv, .csv.gz or .csv.zst file
+     *
+     * @throws invalid_argument if the codec was not compiled in
+     */
+    [[nodiscard]] std::unique_ptr<std::istream> openInput(const char* fileName);
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End decompress header file */
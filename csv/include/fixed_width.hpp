@@ -0,0 +1,290 @@
+#ifndef NOP_CSV_FIXED_WIDTH_HPP   /* Begin fixed width header file */
+#define NOP_CSV_FIXED_WIDTH_HPP 1
+
+#include <tuple>
+#include <array>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <ranges>
+#include <concepts>
+#include <utility>
+#include <cstdint>
+#include <boost/type_index.hpp>
+#include <fmt/format.h>
+#include "exception.hpp"
+#include "convert.hpp"
+#include "generator.hpp"
+#include "writer.hpp"
+#include "ingest.hpp"
+#include "thread_pool.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Byte range of one field inside a fixed-width record
+     */
+    struct FixedField
+    {
+      size_t offset;
+      size_t length;
+    };
+
+    /**
+     * @brief Layout whose records end with the symbol Cfg::Terminator
+     */
+    template<class Cfg>
+    concept TerminatedRecords = requires
+    {
+      { Cfg::Terminator } -> std::convertible_to<char>;
+    };
+
+    /**
+     * @brief Layout of fixed-width records
+     *
+     * Cfg::Fields is a constexpr std::array<FixedField, N>, Cfg::RecordSize
+     * the size of a record including a trailing terminator (if any) and
+     * Cfg::Padding the symbol that pads fields on either side. With an optional
+     * Cfg::Terminator the last byte of every record is checked against it, so
+     * fields must not cover that byte.
+     */
+    template<class Cfg>
+    concept FixedWidthConfig = requires
+    {
+      { Cfg::Fields.size() } -> std::convertible_to<size_t>;
+      { Cfg::Fields[0].offset } -> std::convertible_to<size_t>;
+      { Cfg::RecordSize } -> std::convertible_to<size_t>;
+      { Cfg::Padding } -> std::convertible_to<char>;
+    } && std::ranges::all_of(Cfg::Fields, [](const FixedField& field)
+    {
+      return field.length > 0UL && field.offset + field.length + (TerminatedRecords<Cfg> == true ? 1UL : 0UL) <= Cfg::RecordSize;
+    });
+
+    /**
+     * @brief Parser of fixed-width records
+     *
+     * @class FixedWidthParser
+     *
+     * @tparam Cfg Record layout satisfying FixedWidthConfig
+     * @tparam Types... Field types, converted with FieldTraits like in Parser
+     *
+     * Field offsets are compile-time constants, so a record is converted
+     * straight out of the read buffer without scanning for delimiters. The
+     * padding around a field is trimmed before the conversion. The last
+     * record may miss its terminator, any shorter remainder is an error. With
+     * TerminatedRecords a record whose terminator is misplaced is an error
+     * too, instead of shifting every record after it.
+     */
+    template<FixedWidthConfig Cfg, ConvertibleField... Types>
+    requires (Cfg::Fields.size() == sizeof...(Types))
+    class FixedWidthParser
+    {
+    public:
+      using Row = std::tuple<Types...>;
+
+      static constexpr size_t BlockRecords{std::max<size_t>((1UL << 20) / Cfg::RecordSize, 1UL)};
+
+    private:
+      /* Bytes a record without its terminator needs at least */
+      static constexpr size_t MinimalSize{std::ranges::max(Cfg::Fields | std::views::transform([](const FixedField& field)
+      {
+        return field.offset + field.length;
+      }))};
+
+    private:
+      std::istream* m_in;
+      uint64_t m_limit;
+      uint64_t m_record;
+      std::unique_ptr<char[]> m_block;
+      Row m_row;
+      Generator<Row&> m_generator;
+
+    private:
+      [[nodiscard]] static constexpr std::string_view trim(std::string_view field) noexcept
+      {
+        size_t begin{field.find_first_not_of(Cfg::Padding)};
+
+        if (begin == std::string_view::npos)
+          return {};
+
+        return field.substr(begin, field.find_last_not_of(Cfg::Padding) + 1UL - begin);
+      }
+
+      template<size_t... Indices>
+      void convert(const char* record, std::index_sequence<Indices...>)
+      {
+        ([&]
+        {
+          constexpr FixedField field{Cfg::Fields[Indices]};
+          using Type = std::tuple_element_t<Indices, Row>;
+
+          if (FieldTraits<Type>::parse(trim(std::string_view{record + field.offset, field.length}), std::get<Indices>(m_row)) == false)
+            throw err::FormatError{fmt::format(
+                  "\033[1;35m[ERROR]\033[0m Invalid data type.\n"
+                  "\033[1;35m[MESSAGE]\033[0m The expected type was : {}\n"
+                  "\033[1;35m[MESSAGE]\033[0m Parse error position : <Record:{};Bytes:{}-{}>"
+                  , boost::typeindex::type_id<Type>().pretty_name()
+                  , m_record
+                  , field.offset
+                  , field.offset + field.length)};
+        }(), ...);
+      }
+
+      [[nodiscard]] Generator<Row&> generate()
+      {
+        constexpr size_t BlockSize{BlockRecords * Cfg::RecordSize};
+
+        for (;;)
+        {
+          size_t wanted{static_cast<size_t>(std::min<uint64_t>(BlockSize, m_limit))};
+          m_in->read(m_block.get(), static_cast<std::streamsize>(wanted));
+          size_t read{static_cast<size_t>(m_in->gcount())};
+          size_t records{read / Cfg::RecordSize};
+
+          m_limit -= read;
+
+          /* A short read only happens at the end of the input */
+          if (read % Cfg::RecordSize >= MinimalSize)
+            ++records;
+          else if (read % Cfg::RecordSize != 0UL)
+            throw err::FormatError{fmt::format(
+                  "\033[1;35m[ERROR]\033[0m Truncated record.\n"
+                  "\033[1;35m[MESSAGE]\033[0m Record : {}, size : {}, expected : {}"
+                  , m_record + read / Cfg::RecordSize
+                  , read % Cfg::RecordSize
+                  , Cfg::RecordSize)};
+
+          for (size_t i{}; i < records; ++i)
+          {
+            if constexpr (TerminatedRecords<Cfg> == true)
+            {
+              if (i < read / Cfg::RecordSize && m_block[(i + 1UL) * Cfg::RecordSize - 1UL] != Cfg::Terminator)
+                throw err::FormatError{fmt::format(
+                      "\033[1;35m[ERROR]\033[0m Invalid record terminator.\n"
+                      "\033[1;35m[MESSAGE]\033[0m Record : {}, expected terminator at byte : {}"
+                      , m_record
+                      , Cfg::RecordSize - 1UL)};
+            }
+
+            convert(m_block.get() + i * Cfg::RecordSize, std::index_sequence_for<Types...>{});
+            co_yield m_row;
+            ++m_record;
+          }
+
+          if (read < wanted || m_limit == 0UL)
+            co_return;
+        }
+      }
+
+    public:
+      /**
+       * @brief FixedWidthParser constructor
+       *
+       * @param [in] in Input stream
+       * @param [in] skipRecords Records skipped first (e.g. a header record)
+       * @param [in] limit Number of bytes to read at most, counted from the first skipped record
+       *
+       * @throws invalid_argument
+       */
+      FixedWidthParser(std::istream& in, size_t skipRecords, uint64_t limit = UINT64_MAX)
+        : m_in{&in}
+        , m_limit{limit}
+        , m_record{skipRecords}
+        , m_block{std::make_unique<char[]>(BlockRecords * Cfg::RecordSize)}
+        , m_row{}
+        , m_generator{}
+      {
+        if (in.good() == false)
+          throw err::InvalidArgument{"\033[1;35m[ERROR]\033[0m Invalid file stream.\n"
+                                     "\033[1;35m[MESSAGE]\033[0m Cannot parse the file."};
+
+        uint64_t skipped{std::min<uint64_t>(skipRecords * Cfg::RecordSize, m_limit)};
+        in.ignore(static_cast<std::streamsize>(skipped));
+        m_limit -= static_cast<uint64_t>(in.gcount());
+        m_generator = generate();
+      }
+
+      FixedWidthParser(const FixedWidthParser&) = delete;
+      FixedWidthParser(FixedWidthParser&&) = delete;
+      ~FixedWidthParser() = default;
+
+      /**
+       * @brief Parses up to the first record
+       *
+       * @throws format_error
+       */
+      [[nodiscard]] auto begin()
+      {
+        return m_generator.begin();
+      }
+
+      [[nodiscard]] auto end() const noexcept
+      {
+        return m_generator.end();
+      }
+
+      FixedWidthParser& operator=(const FixedWidthParser&) = delete;
+      FixedWidthParser& operator=(FixedWidthParser&&) = delete;
+    };
+
+    /**
+     * @brief Converts chunks of fixed-width files to csv on a work-stealing pool
+     *
+     * @tparam Cfg Record layout satisfying FixedWidthConfig
+     * @tparam OutCfg Configuration class of the written csv
+     * @tparam Types... Field types
+     *
+     * @param [in] chunks Tasks produced by splitRecords
+     * @param [in] skipRecords Records skipped at the start of every file
+     * @param [in] pool Pool the chunks are parsed on
+     * @param [in] file Output descriptor shared by all tasks
+     * @param [in] lock Mutex serializing writes to the output descriptor
+     *
+     * @return Number of parsed records
+     *
+     * @throws format_error, invalid_argument, system_error
+     */
+    template<FixedWidthConfig Cfg, class OutCfg, ConvertibleField... Types>
+    size_t ingestFixedWidth(const std::vector<FileChunk>& chunks, size_t skipRecords, ThreadPool& pool, int32_t file, std::mutex& lock)
+    {
+      std::atomic<size_t> records{0UL};
+
+      for (const auto& chunk : chunks)
+        pool.submit([&chunk, &records, &lock, skipRecords, file]
+        {
+          Writer<OutCfg, Types...> out{file, lock};
+          size_t count{};
+
+          consumeChunk(chunk, skipRecords, [&](std::istream& in, size_t skip, uint64_t limit)
+          {
+            FixedWidthParser<Cfg, Types...> prs{in, skip, limit};
+
+            for (auto&& row : prs)
+            {
+              out << row;
+              ++count;
+            }
+          });
+
+          out.flush();
+          records.fetch_add(count, std::memory_order_relaxed);
+        });
+
+      pool.wait();
+      return records.load(std::memory_order_relaxed);
+    }
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End fixed width header file */
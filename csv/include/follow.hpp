@@ -0,0 +1,102 @@
+#ifndef NOP_CSV_FOLLOW_HPP   /* Begin follow header file */
+#define NOP_CSV_FOLLOW_HPP 1
+
+#include <istream>
+#include <streambuf>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+#include <sys/types.h>
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Stream buffer that keeps reading a file while it is being appended to
+     *
+     * @class FollowBuf
+     *
+     * Reaching the end of the file does not end the stream: underflow() blocks
+     * until the file grows (inotify, or fstat polling when inotify is missing)
+     * and then reads only the new bytes. The parser consuming the stream never
+     * sees a premature end, so a row split across two appends is completed in
+     * place and the cost per byte does not depend on the file size. The stream
+     * ends once the stop flag is raised while waiting.
+     */
+    class FollowBuf : public std::streambuf
+    {
+    public:
+      static constexpr size_t BufferSize{1UL << 16};
+
+      using IdleHandler = std::function<void()>;
+
+    private:
+      int32_t m_file;
+      int32_t m_notify;
+      off_t m_offset;
+      std::unique_ptr<char[]> m_buffer;
+      const std::atomic<bool>* m_stop;
+      std::chrono::milliseconds m_interval;
+      IdleHandler m_idle;
+
+    private:
+      [[nodiscard]] bool waitForGrowth();
+
+    protected:
+      int_type underflow() override;
+      pos_type seekoff(off_type, std::ios_base::seekdir, std::ios_base::openmode) override;
+      pos_type seekpos(pos_type, std::ios_base::openmode) override;
+
+    public:
+      FollowBuf(const char*, const std::atomic<bool>&, IdleHandler, std::chrono::milliseconds);
+      FollowBuf(const FollowBuf&) = delete;
+      FollowBuf(FollowBuf&&) = delete;
+      ~FollowBuf() override;
+
+      [[nodiscard]] bool isOpen() const noexcept;
+
+      FollowBuf& operator=(const FollowBuf&) = delete;
+      FollowBuf& operator=(FollowBuf&&) = delete;
+    };
+
+    /**
+     * @brief Input stream that follows a growing csv file
+     *
+     * @class FollowStream
+     */
+    class FollowStream : public std::istream
+    {
+    private:
+      FollowBuf m_buffer;
+
+    public:
+      /**
+       * @brief FollowStream constructor
+       *
+       * @param [in] fileName Path to the followed file
+       * @param [in] stop Flag that ends the stream the next time it waits for data
+       * @param [in] idle Called before every wait (e.g. to flush buffered output)
+       * @param [in] interval Upper bound for a single wait between stop flag checks
+       */
+      FollowStream(const char* fileName,
+                   const std::atomic<bool>& stop,
+                   FollowBuf::IdleHandler idle = {},
+                   std::chrono::milliseconds interval = std::chrono::milliseconds{200});
+      FollowStream(const FollowStream&) = delete;
+      FollowStream(FollowStream&&) = delete;
+      ~FollowStream() override = default;
+
+      FollowStream& operator=(const FollowStream&) = delete;
+      FollowStream& operator=(FollowStream&&) = delete;
+    };
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End follow header file */
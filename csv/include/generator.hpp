@@ -0,0 +1,193 @@
+#ifndef NOP_CSV_GENERATOR_HPP   /* Begin generator header file */
+#define NOP_CSV_GENERATOR_HPP 1
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Lazy single-pass coroutine range
+     *
+     * @class Generator
+     *
+     * @tparam Reference Type produced by dereferencing the iterator (usually T&)
+     *
+     * Minimal stand-in for C++23 std::generator: the coroutine frame is the only
+     * allocation, yielded values are exposed by address (no copy per element)
+     * and the type models std::ranges::view, so it composes with range adaptors.
+     */
+    template<typename Reference>
+    class Generator : public std::ranges::view_interface<Generator<Reference>>
+    {
+    public:
+      using value_type = std::remove_cvref_t<Reference>;
+
+      class promise_type
+      {
+      private:
+        std::add_pointer_t<std::remove_reference_t<Reference>> m_value;
+        std::exception_ptr m_error;
+
+        friend class Generator;
+
+      public:
+        [[nodiscard]] Generator get_return_object() noexcept
+        {
+          return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        [[nodiscard]] std::suspend_always initial_suspend() const noexcept
+        {
+          return {};
+        }
+
+        [[nodiscard]] std::suspend_always final_suspend() const noexcept
+        {
+          return {};
+        }
+
+        std::suspend_always yield_value(std::remove_reference_t<Reference>& value) noexcept
+        {
+          m_value = std::addressof(value);
+          return {};
+        }
+
+        /* A yielded temporary lives in the coroutine frame until the next resume */
+        std::suspend_always yield_value(std::remove_reference_t<Reference>&& value) noexcept
+        requires (std::is_lvalue_reference_v<Reference> == false)
+        {
+          m_value = std::addressof(value);
+          return {};
+        }
+
+        void return_void() const noexcept
+        {}
+
+        void unhandled_exception() noexcept
+        {
+          m_error = std::current_exception();
+        }
+
+        template<typename Awaitable>
+        void await_transform(Awaitable&&) = delete;
+      };
+
+    private:
+      using Handle = std::coroutine_handle<promise_type>;
+
+    public:
+      class Iterator
+      {
+      private:
+        Handle m_coroutine;
+
+      public:
+        using value_type = Generator::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() noexcept = default;
+
+        explicit Iterator(Handle coroutine) noexcept
+          : m_coroutine{coroutine}
+        {}
+
+        [[nodiscard]] Reference operator*() const noexcept
+        {
+          return static_cast<Reference>(*m_coroutine.promise().m_value);
+        }
+
+        Iterator& operator++()
+        {
+          m_coroutine.resume();
+          Generator::rethrow(m_coroutine);
+          return *this;
+        }
+
+        void operator++(int)
+        {
+          ++(*this);
+        }
+
+        [[nodiscard]] friend bool operator==(const Iterator& iterator, std::default_sentinel_t) noexcept
+        {
+          return iterator.m_coroutine.done();
+        }
+      };
+
+    private:
+      Handle m_coroutine;
+
+    private:
+      explicit Generator(Handle coroutine) noexcept
+        : m_coroutine{coroutine}
+      {}
+
+      static void rethrow(Handle coroutine)
+      {
+        if (coroutine.done() == true && coroutine.promise().m_error != nullptr)
+          std::rethrow_exception(std::exchange(coroutine.promise().m_error, nullptr));
+      }
+
+    public:
+      Generator() noexcept = default;
+
+      Generator(const Generator&) = delete;
+
+      Generator(Generator&& other) noexcept
+        : m_coroutine{std::exchange(other.m_coroutine, nullptr)}
+      {}
+
+      ~Generator()
+      {
+        if (m_coroutine)
+          m_coroutine.destroy();
+      }
+
+      /**
+       * @brief Runs the coroutine up to the first element
+       *
+       * @throws whatever the coroutine body throws
+       */
+      [[nodiscard]] Iterator begin()
+      {
+        m_coroutine.resume();
+        rethrow(m_coroutine);
+        return Iterator{m_coroutine};
+      }
+
+      [[nodiscard]] std::default_sentinel_t end() const noexcept
+      {
+        return {};
+      }
+
+      Generator& operator=(const Generator&) = delete;
+
+      Generator& operator=(Generator&& other) noexcept
+      {
+        if (this != &other)
+        {
+          if (m_coroutine)
+            m_coroutine.destroy();
+
+          m_coroutine = std::exchange(other.m_coroutine, nullptr);
+        }
+
+        return *this;
+      }
+    };
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End generator header file */
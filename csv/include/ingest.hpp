@@ -0,0 +1,190 @@
+#ifndef NOP_CSV_INGEST_HPP   /* Begin ingest header file */
+#define NOP_CSV_INGEST_HPP 1
+
+#include <vector>
+#include <string>
+#include <span>
+#include <spanstream>
+#include <fstream>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <fmt/format.h>
+#include "exception.hpp"
+#include "parser.hpp"
+#include "writer.hpp"
+#include "decompress.hpp"
+#include "thread_pool.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Byte range of one input file parsed as an independent task
+     *
+     * @struct FileChunk
+     *
+     * A whole chunk is read through openInput (it may be compressed, end is
+     * then the compressed size), any other one is read as plain bytes.
+     */
+    struct FileChunk
+    {
+      std::string fileName;
+      uint64_t begin;
+      uint64_t end;
+      bool whole;
+
+      [[nodiscard]] bool isFirst() const noexcept
+      {
+        return begin == 0UL;
+      }
+
+      [[nodiscard]] uint64_t size() const noexcept
+      {
+        return end - begin;
+      }
+    };
+
+    /**
+     * @brief Splits files into row aligned chunks, largest chunk first
+     *
+     * @param [in] files Input paths (compressed files are never split)
+     * @param [in] chunkSize Target chunk size in bytes, 0 disables splitting
+     * @param [in] row Row symbol chunks are aligned to
+     *
+     * A chunk boundary is placed right after the first Row symbol found at or
+     * past every chunkSize bytes. Boundaries do not track quoting, so files
+     * whose quoted fields contain Row symbols must be parsed unsplit.
+     *
+     * @throws invalid_argument
+     */
+    [[nodiscard]] std::vector<FileChunk> splitFiles(const std::vector<std::string>& files, uint64_t chunkSize, char row);
+
+    /**
+     * @brief Splits files of fixed-size records into record aligned chunks, largest chunk first
+     *
+     * @param [in] files Input paths (compressed files are never split)
+     * @param [in] chunkSize Target chunk size in bytes, 0 disables splitting
+     * @param [in] recordSize Size of a record, chunk sizes are its multiples
+     *
+     * Boundaries are computed from the file size alone, nothing is read.
+     *
+     * @throws invalid_argument
+     */
+    [[nodiscard]] std::vector<FileChunk> splitRecords(const std::vector<std::string>& files, uint64_t chunkSize, uint64_t recordSize);
+
+    /**
+     * @brief Opens a chunk and hands it to consume
+     *
+     * @param [in] chunk Task produced by splitFiles or splitRecords
+     * @param [in] skipLines Lines (or records) skipped at the start of every file
+     * @param [in] consume Called as consume(std::istream& in, size_t skip, uint64_t limit)
+     *
+     * A whole chunk is read through openInput with no byte limit, any other one
+     * from its first byte of the plain file with a limit of its size, and only
+     * the first chunk of a file skips lines. Format errors get the chunk added
+     * to their message, since row numbers of a chunk are relative to its first byte.
+     *
+     * @throws format_error, invalid_argument
+     */
+    template<typename Consumer>
+    void consumeChunk(const FileChunk& chunk, size_t skipLines, Consumer&& consume)
+    {
+      try
+      {
+        if (chunk.whole == true)
+          consume(*openInput(chunk.fileName.c_str()), skipLines, UINT64_MAX);
+        else
+        {
+          std::ifstream in{chunk.fileName, std::ios_base::binary};
+          in.seekg(static_cast<std::streamoff>(chunk.begin));
+          consume(in, chunk.isFirst() == true ? skipLines : 0UL, chunk.size());
+        }
+      }
+      catch (const err::FormatError& error)
+      {
+        throw err::FormatError{fmt::format(
+              "{}\n\033[1;35m[MESSAGE]\033[0m File : {}, chunk starting at byte {}"
+              , error.what()
+              , chunk.fileName
+              , chunk.begin)};
+      }
+    }
+
+    /**
+     * @brief Parses chunks on a work-stealing pool into one shared output
+     *
+     * @tparam Cfg Configuration class that consists of char enum providing symbols
+     * @tparam Types... Variadic number of types
+     *
+     * @param [in] chunks Tasks produced by splitFiles
+     * @param [in] skipLines Lines skipped at the start of every file
+     * @param [in] pool Pool the chunks are parsed on
+     * @param [in] file Output descriptor shared by all tasks
+     * @param [in] lock Mutex serializing writes to the output descriptor
+     *
+     * Every task writes through its own Writer, so rows of one chunk keep
+     * their order while rows of different chunks interleave.
+     *
+     * @return Number of parsed rows
+     *
+     * @throws format_error, invalid_argument, system_error
+     */
+    template<class Cfg, typename... Types>
+    size_t ingestFiles(const std::vector<FileChunk>& chunks, size_t skipLines, ThreadPool& pool, int32_t file, std::mutex& lock)
+    {
+      std::atomic<size_t> rows{0UL};
+
+      for (const auto& chunk : chunks)
+        pool.submit([&chunk, &rows, &lock, skipLines, file]
+        {
+          Writer<Cfg, Types...> out{file, lock};
+          size_t count{};
+
+          auto parse{[&](std::istream& in, size_t skip)
+          {
+            Parser<Cfg, Types...> prs{in, skip};
+
+            for (auto&& row : prs)
+            {
+              out << row;
+              ++count;
+            }
+          }};
+
+          consumeChunk(chunk, skipLines, [&](std::istream& in, size_t skip, uint64_t limit)
+          {
+            if (limit == UINT64_MAX)
+              return parse(in, skip);
+
+            /* Parser has no byte limit, a split chunk is parsed from memory */
+            std::string text(static_cast<size_t>(limit), '\0');
+
+            if (in.read(text.data(), static_cast<std::streamsize>(text.size())).good() == false)
+              throw err::SystemError{fmt::format(
+                    "\033[1;35m[ERROR]\033[0m Cannot read csv chunk.\n"
+                    "\033[1;35m[MESSAGE]\033[0m File : {}, bytes : {}-{}"
+                    , chunk.fileName
+                    , chunk.begin
+                    , chunk.end)};
+
+            std::ispanstream span{std::span<char>{text}};
+            parse(span, skip);
+          });
+
+          out.flush();
+          rows.fetch_add(count, std::memory_order_relaxed);
+        });
+
+      pool.wait();
+      return rows.load(std::memory_order_relaxed);
+    }
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End ingest header file */
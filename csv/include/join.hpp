@@ -0,0 +1,305 @@
+#ifndef NOP_CSV_JOIN_HPP   /* Begin join header file */
+#define NOP_CSV_JOIN_HPP 1
+
+#include <tuple>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <utility>
+#include <bit>
+#include <limits>
+#include <functional>
+#include <type_traits>
+#include "spill.hpp"
+#include "generator.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    template<size_t BuildColumn, size_t ProbeColumn, class Build, class Probe>
+    class HashJoin;
+
+    /**
+     * @brief Streaming inner equi-join of two row sources
+     *
+     * @class HashJoin
+     *
+     * @tparam BuildColumn Key column of the build rows
+     * @tparam ProbeColumn Key column of the probe rows (same type as the build key)
+     * @tparam BuildTypes... Column types of the build side (the smaller input)
+     * @tparam ProbeTypes... Column types of the probe side
+     *
+     * The build rows are indexed by an open-addressing table (linear probing,
+     * hash cached per slot, load factor at most 1/2) and the probe rows stream
+     * through it. When the build side outgrows the memory budget, both sides
+     * are partitioned by hash into Fanout spill files (grace join). Partitions
+     * are joined one at a time and re-partitioned on the next hash bits if
+     * they are still too large. After MaxDepth levels the partition is loaded
+     * whole, since it then consists of very few distinct keys.
+     */
+    template<size_t BuildColumn, size_t ProbeColumn, SpillableField... BuildTypes, SpillableField... ProbeTypes>
+    class HashJoin<BuildColumn, ProbeColumn, std::tuple<BuildTypes...>, std::tuple<ProbeTypes...>>
+    {
+    public:
+      using BuildRow = std::tuple<BuildTypes...>;
+      using ProbeRow = std::tuple<ProbeTypes...>;
+      using Match = std::pair<const ProbeRow&, const BuildRow&>;
+
+      static constexpr size_t Fanout{16UL};
+      static constexpr size_t MaxDepth{8UL};
+
+    private:
+      using Key = std::tuple_element_t<BuildColumn, BuildRow>;
+
+      static_assert(std::is_same_v<Key, std::tuple_element_t<ProbeColumn, ProbeRow>> == true,
+                    "Join key columns must have the same type");
+
+      struct Slot
+      {
+        uint64_t hash;
+        uint32_t row;
+      };
+
+      struct Partition
+      {
+        std::unique_ptr<SpillFile> build;
+        std::unique_ptr<SpillFile> probe;
+        size_t depth;
+      };
+
+      static constexpr uint32_t Empty{std::numeric_limits<uint32_t>::max()};
+
+    private:
+      size_t m_memory;
+      std::string m_directory;
+      std::vector<BuildRow> m_rows;
+      size_t m_bytes;
+      std::vector<Slot> m_slots;
+      std::vector<Partition> m_partitions;
+
+    private:
+      /* Identity hashes of integers would cluster under linear probing, so every hash is finalized */
+      [[nodiscard]] static uint64_t hash(const Key& key) noexcept
+      {
+        uint64_t value;
+
+        if constexpr (std::is_same_v<Key, std::string> == true)
+          value = std::hash<std::string_view>{}(key);
+        else
+          value = std::hash<Key>{}(key);
+
+        value ^= value >> 33U;
+        value *= 0xff51afd7ed558ccdUL;
+        value ^= value >> 33U;
+        value *= 0xc4ceb9fe1a85ec53UL;
+        value ^= value >> 33U;
+        return value;
+      }
+
+      /* Slots use the low hash bits, every partitioning level the next four high ones */
+      [[nodiscard]] static size_t partitionOf(uint64_t hash, size_t depth) noexcept
+      {
+        return static_cast<size_t>(hash >> (60UL - 4UL * depth)) & (Fanout - 1UL);
+      }
+
+      void keep(BuildRow&& row)
+      {
+        m_bytes += footprint(row) + 2UL * sizeof(Slot);
+        m_rows.push_back(std::move(row));
+      }
+
+      void index()
+      {
+        m_slots.assign(std::bit_ceil(std::max(m_rows.size() * 2UL, 16UL)), Slot{0UL, Empty});
+        size_t mask{m_slots.size() - 1UL};
+
+        for (size_t row{}; row < m_rows.size(); ++row)
+        {
+          uint64_t code{hash(std::get<BuildColumn>(m_rows[row]))};
+          size_t slot{code & mask};
+
+          while (m_slots[slot].row != Empty)
+            slot = (slot + 1UL) & mask;
+
+          m_slots[slot] = Slot{code, static_cast<uint32_t>(row)};
+        }
+      }
+
+      /* Moves the rows held in memory into Fanout new partitions of the given level */
+      [[nodiscard]] std::vector<Partition> split(size_t depth)
+      {
+        std::vector<Partition> partitions(Fanout);
+
+        for (auto& partition : partitions)
+        {
+          partition.build = std::make_unique<SpillFile>(m_directory.c_str());
+          partition.probe = std::make_unique<SpillFile>(m_directory.c_str());
+          partition.depth = depth;
+        }
+
+        for (const auto& row : m_rows)
+          partitions[partitionOf(hash(std::get<BuildColumn>(row)), depth)].build->writeRow(row);
+
+        m_rows = {};
+        m_slots = {};
+        m_bytes = 0UL;
+        return partitions;
+      }
+
+      /* First slot from the given one on that holds the key, or the empty slot ending the cluster */
+      [[nodiscard]] size_t find(const Key& key, uint64_t code, size_t slot) const noexcept
+      {
+        size_t mask{m_slots.size() - 1UL};
+
+        while (m_slots[slot].row != Empty &&
+               (m_slots[slot].hash != code || std::get<BuildColumn>(m_rows[m_slots[slot].row]) != key))
+          slot = (slot + 1UL) & mask;
+
+        return slot;
+      }
+
+    public:
+      /**
+       * @brief HashJoin constructor
+       *
+       * @param [in] memory Memory budget in bytes for the build side
+       * @param [in] directory Directory for partition files
+       */
+      explicit HashJoin(size_t memory, std::string directory = defaultSpillDirectory())
+        : m_memory{memory}
+        , m_directory{std::move(directory)}
+        , m_bytes{0UL}
+      {}
+
+      HashJoin(const HashJoin&) = delete;
+      HashJoin(HashJoin&&) = delete;
+      ~HashJoin() = default;
+
+      /**
+       * @brief Consumes the build side
+       *
+       * @param [in] rows Range of BuildRow, e.g. a Parser (rows are moved from)
+       *
+       * @throws format_error from the parser, system_error if partitioning fails
+       */
+      template<class Range>
+      void build(Range& rows)
+      {
+        for (auto&& row : rows)
+        {
+          if (m_partitions.empty() == false)
+          {
+            m_partitions[partitionOf(hash(std::get<BuildColumn>(row)), 0UL)].build->writeRow(row);
+            continue;
+          }
+
+          keep(BuildRow{std::move(row)});
+
+          if (m_bytes > m_memory)
+            m_partitions = split(0UL);
+        }
+
+        if (m_partitions.empty() == true)
+          index();
+      }
+
+      /**
+       * @brief Streams the probe side through the build side
+       *
+       * Must be called once, after build(). The range must outlive the returned
+       * generator. Every element pairs a probe row with one matching build row
+       * and is valid until the next one is produced.
+       *
+       * @param [in] rows Range of ProbeRow, e.g. a Parser
+       *
+       * @throws format_error from the parser, system_error if partitioning fails (while iterating)
+       */
+      template<class Range>
+      [[nodiscard]] Generator<Match> probe(Range& rows)
+      {
+        if (m_partitions.empty() == true)
+        {
+          for (const auto& row : rows)
+          {
+            const Key& key{std::get<ProbeColumn>(row)};
+            uint64_t code{hash(key)};
+
+            for (size_t slot{find(key, code, code & (m_slots.size() - 1UL))}; m_slots[slot].row != Empty;
+                 slot = find(key, code, (slot + 1UL) & (m_slots.size() - 1UL)))
+              co_yield Match{row, m_rows[m_slots[slot].row]};
+          }
+
+          co_return;
+        }
+
+        for (const auto& row : rows)
+          m_partitions[partitionOf(hash(std::get<ProbeColumn>(row)), 0UL)].probe->writeRow(row);
+
+        std::vector<Partition> pending{std::move(m_partitions)};
+        BuildRow buildRow;
+        ProbeRow probeRow;
+
+        while (pending.empty() == false)
+        {
+          Partition partition{std::move(pending.back())};
+          pending.pop_back();
+          partition.build->rewind();
+          partition.probe->rewind();
+
+          bool overflow{false};
+
+          while (overflow == false && partition.build->readRow(buildRow) == true)
+          {
+            keep(std::move(buildRow));
+            overflow = m_bytes > m_memory && partition.depth + 1UL < MaxDepth;
+          }
+
+          if (overflow == true)
+          {
+            std::vector<Partition> children{split(partition.depth + 1UL)};
+
+            while (partition.build->readRow(buildRow) == true)
+              children[partitionOf(hash(std::get<BuildColumn>(buildRow)), partition.depth + 1UL)].build->writeRow(buildRow);
+
+            while (partition.probe->readRow(probeRow) == true)
+              children[partitionOf(hash(std::get<ProbeColumn>(probeRow)), partition.depth + 1UL)].probe->writeRow(probeRow);
+
+            for (auto& child : children)
+              pending.push_back(std::move(child));
+
+            continue;
+          }
+
+          if (m_rows.empty() == false)
+          {
+            index();
+
+            while (partition.probe->readRow(probeRow) == true)
+            {
+              const Key& key{std::get<ProbeColumn>(probeRow)};
+              uint64_t code{hash(key)};
+
+              for (size_t slot{find(key, code, code & (m_slots.size() - 1UL))}; m_slots[slot].row != Empty;
+                   slot = find(key, code, (slot + 1UL) & (m_slots.size() - 1UL)))
+                co_yield Match{probeRow, m_rows[m_slots[slot].row]};
+            }
+          }
+
+          m_rows.clear();
+          m_bytes = 0UL;
+        }
+      }
+
+      HashJoin& operator=(const HashJoin&) = delete;
+      HashJoin& operator=(HashJoin&&) = delete;
+    };
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End join header file */
@@ -2,14 +2,22 @@
 #define NOP_CSV_PARSER_HPP 1
 
 #include <ostream>
+#include <istream>
+#include <utility>
 #include <tuple>
 #include <sstream>
 #include <fstream>
 #include <memory>
+#include <string>
+#include <functional>
 #include <type_traits>
 #include <boost/type_index.hpp>
 #include <fmt/format.h>
 #include "exception.hpp"
+#include "checkpoint.hpp"
+#include "convert.hpp"
+#include "generator.hpp"
+#include "utf8.hpp"
 
 namespace nop /* Begin namespace nop */
 {
@@ -73,6 +81,31 @@ namespace nop /* Begin namespace nop */
       };
     };
 
+    struct TsvCfg
+    {
+    public:
+      enum Symbol : char
+      {
+        Column = '\t',
+        Row = '\n',
+        Escape = '\"'
+      };
+    };
+
+    /* Comma separated values whose string fields must be valid UTF-8 */
+    struct Utf8Cfg
+    {
+    public:
+      enum Symbol : char
+      {
+        Column = ',',
+        Row = '\n',
+        Escape = '\"'
+      };
+
+      static constexpr bool ValidateUtf8{true};
+    };
+
     /**
      * @brief Parser class for parsing csv files
      *
@@ -80,24 +113,37 @@ namespace nop /* Begin namespace nop */
      *
      * @tparam Cfg Configuration class that consists of char enum providing symbols
      * @tparam Types... Variadic number of types
+     *
+     * With a Cfg satisfying ValidatesUtf8 every string field is checked for
+     * invalid UTF-8 right after it is read. Inside an escaped field a doubled
+     * Escape symbol stands for one literal Escape, the form Writer produces.
      */
     template<class Cfg, typename... Types>
     class Parser
     {
+    public:
+      using SaveHandler = std::function<void()>;
+
     private:
       class ControlBlock
       {
       private:
-        std::ifstream* input;
+        std::istream* input;
         size_t m_row;
         size_t m_column;
         std::tuple<Types...> m_storage;
+        std::string m_checkpointPath;
+        size_t m_checkpointInterval;
+        size_t m_sinceCheckpoint;
+        SaveHandler m_beforeSave;
 
       public:
-        ControlBlock(std::ifstream* in, size_t skipLines)
+        ControlBlock(std::istream* in, size_t skipLines)
           : input{in}
           , m_row{skipLines}
           , m_column{1UL}
+          , m_checkpointInterval{0UL}
+          , m_sinceCheckpoint{0UL}
         {}
 
         ControlBlock(const ControlBlock&) = delete;
@@ -115,7 +161,37 @@ namespace nop /* Begin namespace nop */
           m_column = 1UL;
         }
 
-        [[nodiscard]] std::ifstream* getStream() noexcept
+        void setCheckpoint(std::string&& path, size_t interval, SaveHandler&& beforeSave) noexcept
+        {
+          m_checkpointPath = std::move(path);
+          m_checkpointInterval = interval;
+          m_sinceCheckpoint = 0UL;
+          m_beforeSave = std::move(beforeSave);
+        }
+
+        /*
+         * Called before the next row is parsed: every row up to m_row has been
+         * handed to the caller. The caller may still buffer them, so m_beforeSave
+         * runs first (e.g. to flush the output) and only then is the position saved.
+         */
+        void checkpoint()
+        {
+          if (m_checkpointInterval == 0UL || ++m_sinceCheckpoint < m_checkpointInterval)
+            return;
+
+          m_sinceCheckpoint = 0UL;
+          std::streamoff offset{input->tellg()};
+
+          if (offset < 0)
+            return;
+
+          if (m_beforeSave)
+            m_beforeSave();
+
+          Checkpoint{static_cast<uint64_t>(offset), m_row, false}.save(m_checkpointPath.c_str());
+        }
+
+        [[nodiscard]] std::istream* getStream() noexcept
         {
           return input;
         }
@@ -181,21 +257,34 @@ namespace nop /* Begin namespace nop */
               else if (symbol == Cfg::Symbol::Escape)
               {
                 std::string tmpBuffer;
-                std::getline(*(m_block->getStream()), tmpBuffer, std::to_underlying(Cfg::Symbol::Escape));
-                m_buffer->write(tmpBuffer.c_str(), tmpBuffer.length());
-                m_block->getStream()->unget();
-                symbol = m_block->getStream()->get();
 
-                if (symbol != Cfg::Symbol::Escape)
-                  throw err::FormatError{fmt::format(
-                        "\033[1;35m[ERROR]\033[0m Unpaired escape character.\n"
-                        "\033[1;35m[MESSAGE]\033[0m The escape string should be : {}str{}\n"
-                        "\033[1;35m[MESSAGE]\033[0m Parse error position : <Row:{};Column:{}-{}>"
-                        , std::to_underlying(Cfg::Symbol::Escape)
-                        , std::to_underlying(Cfg::Symbol::Escape)
-                        , m_block->getRow()
-                        , startColumn
-                        , m_block->getColumn())};
+                /* A doubled Escape inside an escaped field is one literal Escape */
+                for (bool doubled{false};; doubled = true)
+                {
+                  if (doubled == true)
+                    m_buffer->put(Cfg::Symbol::Escape);
+
+                  std::getline(*(m_block->getStream()), tmpBuffer, std::to_underlying(Cfg::Symbol::Escape));
+                  m_buffer->write(tmpBuffer.c_str(), tmpBuffer.length());
+                  m_block->getStream()->unget();
+                  symbol = m_block->getStream()->get();
+
+                  if (symbol != Cfg::Symbol::Escape)
+                    throw err::FormatError{fmt::format(
+                          "\033[1;35m[ERROR]\033[0m Unpaired escape character.\n"
+                          "\033[1;35m[MESSAGE]\033[0m The escape string should be : {}str{}\n"
+                          "\033[1;35m[MESSAGE]\033[0m Parse error position : <Row:{};Column:{}-{}>"
+                          , std::to_underlying(Cfg::Symbol::Escape)
+                          , std::to_underlying(Cfg::Symbol::Escape)
+                          , m_block->getRow()
+                          , startColumn
+                          , m_block->getColumn())};
+
+                  if (m_block->getStream()->peek() != Cfg::Symbol::Escape)
+                    break;
+
+                  m_block->getStream()->ignore();
+                }
               }
               else
               {
@@ -207,7 +296,31 @@ namespace nop /* Begin namespace nop */
             m_block->incColumn();
 
             if constexpr (std::is_same_v<std::remove_reference_t<decltype(std::get<current>(m_block->getStorage()))>, std::string> == true)
+            {
               std::getline(*m_buffer, std::get<current>(m_block->getStorage()));
+
+              if constexpr (ValidatesUtf8<Cfg> == true)
+              {
+                size_t offset{validateUtf8(std::get<current>(m_block->getStorage()))};
+
+                if (offset != std::string_view::npos)
+                  throw err::FormatError{fmt::format(
+                        "\033[1;35m[ERROR]\033[0m Invalid UTF-8 sequence.\n"
+                        "\033[1;35m[MESSAGE]\033[0m Byte offset in field : {}\n"
+                        "\033[1;35m[MESSAGE]\033[0m Parse error position : <Row:{};Column:{}-{}>"
+                        , offset
+                        , m_block->getRow()
+                        , startColumn
+                        , m_block->getColumn())};
+              }
+            }
+            else if constexpr (std::is_arithmetic_v<std::remove_reference_t<decltype(std::get<current>(m_block->getStorage()))>> == false)
+            {
+              /* Column types with their own FieldTraits (dates, timestamps, ...) */
+              if (FieldTraits<std::remove_reference_t<decltype(std::get<current>(m_block->getStorage()))>>::parse(
+                    m_buffer->view(), std::get<current>(m_block->getStorage())) == false)
+                m_buffer->setstate(std::ios_base::failbit);
+            }
             else
               (*m_buffer) >> std::get<current>(m_block->getStorage());
 
@@ -252,6 +365,7 @@ namespace nop /* Begin namespace nop */
         {
           if (m_block->getStream()->eof() == false)
           {
+            m_block->checkpoint();
             parse<0UL, sizeof...(Types)>();
             m_block->updatePosition();
           }
@@ -281,15 +395,15 @@ namespace nop /* Begin namespace nop */
       /**
        * @brief Parser constructor recieving two parameters
        *
-       * @param [in] in Input file stream representing file to parse
+       * @param [in] in Input stream representing file to parse (plain or decompressed)
        * @param [in] skipLines The number of lines to skip
        *
        * @throws invalid_argument
        */
-      Parser(std::ifstream& in, size_t skipLines)
+      Parser(std::istream& in, size_t skipLines)
         : mainBlock{std::make_shared<ControlBlock>(&in, skipLines)}
       {
-        if (in.is_open() == false)
+        if (in.good() == false)
           throw err::InvalidArgument{"\033[1;35m[ERROR]\033[0m Invalid file stream.\n"
                                      "\033[1;35m[MESSAGE]\033[0m Cannot parse the file."};
 
@@ -298,11 +412,51 @@ namespace nop /* Begin namespace nop */
             --skipLines;
       }
 
+      /**
+       * @brief Parser constructor resuming from a checkpoint
+       *
+       * @param [in] in Seekable input stream over the same file the checkpoint was taken from
+       * @param [in] checkpoint Position saved by a previous run
+       *
+       * @throws invalid_argument
+       */
+      Parser(std::istream& in, const Checkpoint& checkpoint)
+        : mainBlock{std::make_shared<ControlBlock>(&in, checkpoint.row)}
+      {
+        if (in.good() == false)
+          throw err::InvalidArgument{"\033[1;35m[ERROR]\033[0m Invalid file stream.\n"
+                                     "\033[1;35m[MESSAGE]\033[0m Cannot parse the file."};
+
+        /* Parser only checkpoints on row boundaries */
+        if (checkpoint.inQuote == true)
+          throw err::InvalidArgument{"\033[1;35m[ERROR]\033[0m Invalid checkpoint.\n"
+                                     "\033[1;35m[MESSAGE]\033[0m Cannot resume inside an escaped field."};
+
+        if (in.seekg(static_cast<std::streamoff>(checkpoint.offset)).fail() == true)
+          throw err::InvalidArgument{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Invalid checkpoint.\n"
+                "\033[1;35m[MESSAGE]\033[0m Cannot seek to byte offset {}"
+                , checkpoint.offset)};
+      }
+
       Parser(const Parser&) = delete;
       Parser(Parser&&) = delete;
 
       ~Parser() = default;
 
+      /**
+       * @brief Enables periodic checkpoints
+       *
+       * @param [in] path Checkpoint file, replaced atomically on every save
+       * @param [in] interval Number of rows between two checkpoints (0 disables them)
+       * @param [in] beforeSave Called before every save, e.g. to flush the rows
+       *             handed out so far, so a saved position never runs ahead of them
+       */
+      void setCheckpoint(std::string path, size_t interval, SaveHandler beforeSave = {}) noexcept
+      {
+        mainBlock->setCheckpoint(std::move(path), interval, std::move(beforeSave));
+      }
+
       /**
        * @brief Begin method for creating Input Iterator
        *
@@ -321,6 +475,20 @@ namespace nop /* Begin namespace nop */
         return Iterator{mainBlock, nullptr};
       }
 
+      /**
+       * @brief Lazy view over the parsed rows for use with std::ranges adaptors
+       *
+       * The parser must outlive the returned generator. Every element refers to
+       * the same storage that is overwritten by the next row.
+       *
+       * @throws format_error (while iterating)
+       */
+      [[nodiscard]] Generator<std::tuple<Types...>&> rows()
+      {
+        for (auto&& row : *this)
+          co_yield row;
+      }
+
       Parser& operator=(const Parser&) = delete;
       Parser& operator=(Parser&&) = delete;
     };
@@ -0,0 +1,546 @@
+#ifndef NOP_CSV_PIPELINE_HPP   /* Begin pipeline header file */
+#define NOP_CSV_PIPELINE_HPP 1
+
+#include <istream>
+#include <tuple>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <memory>
+#include <thread>
+#include <functional>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <cstring>
+#include <cstdint>
+#include <span>
+#include <boost/type_index.hpp>
+#include <fmt/format.h>
+#include "exception.hpp"
+#include "convert.hpp"
+#include "ring.hpp"
+#include "generator.hpp"
+#include "utf8.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Two-stage csv parser for a single input stream
+     *
+     * @class PipelineParser
+     *
+     * @tparam Cfg Configuration class that consists of char enum providing symbols
+     * @tparam Types... Variadic number of types
+     *
+     * A scanner thread makes the only sequential pass over the input: it resolves
+     * escapes (a doubled Escape inside an escaped field is a literal one) and
+     * cuts the stream into batches of unescaped text plus field and row offsets.
+     * Batches are handed round-robin to conversion workers through lock-free
+     * SPSC rings and collected in the same round-robin order, so rows come out
+     * in file order and quote state never has to be guessed.
+     */
+    template<class Cfg, typename... Types>
+    class PipelineParser
+    {
+      static_assert((ConvertibleField<Types> && ...), "Every column type requires a FieldTraits specialization");
+
+    public:
+      static constexpr size_t MaxWorkers{15UL};
+      static constexpr size_t QueueDepth{4UL};
+      static constexpr size_t BatchBytes{1UL << 16};
+      static constexpr size_t InputSize{1UL << 16};
+
+    private:
+      struct Batch
+      {
+        size_t firstRow;
+        std::string text;
+        std::vector<uint32_t> fieldEnds;
+        std::vector<uint32_t> rowEnds;
+        std::vector<std::tuple<Types...>> rows;
+        size_t count;
+        std::exception_ptr error;
+
+        void reset(size_t row) noexcept
+        {
+          firstRow = row;
+          text.clear();
+          fieldEnds.clear();
+          rowEnds.clear();
+          count = 0UL;
+          error = nullptr;
+        }
+      };
+
+      using BatchPtr = std::unique_ptr<Batch>;
+
+      struct Worker
+      {
+        SpscRing<BatchPtr, QueueDepth> input;
+        SpscRing<BatchPtr, QueueDepth> output;
+        std::thread thread;
+      };
+
+      static constexpr std::array<bool, 256UL> special{[]
+      {
+        std::array<bool, 256UL> table{};
+        table[static_cast<unsigned char>(Cfg::Symbol::Column)] = true;
+        table[static_cast<unsigned char>(Cfg::Symbol::Row)] = true;
+        table[static_cast<unsigned char>(Cfg::Symbol::Escape)] = true;
+        return table;
+      }()};
+
+    private:
+      std::istream* m_input;
+      size_t m_skipLines;
+      std::vector<std::unique_ptr<Worker>> m_workers;
+      SpscRing<BatchPtr, (MaxWorkers + 1UL) * QueueDepth> m_free;
+      std::thread m_scanner;
+      BatchPtr m_current;
+      size_t m_index;
+      size_t m_sequence;
+      bool m_started;
+      bool m_done;
+
+    private:
+      [[nodiscard]] bool dispatch(BatchPtr& batch, size_t& sequence)
+      {
+        Worker& worker{*m_workers[sequence++ % m_workers.size()]};
+        return worker.input.push(std::move(batch));
+      }
+
+      void scan() noexcept
+      {
+        size_t sequence{};
+        size_t row{m_skipLines};
+        BatchPtr batch;
+
+        if (m_free.pop(batch) == false)
+          return;
+
+        batch->reset(row);
+
+        try
+        {
+          for (size_t skipLines{m_skipLines}; skipLines > 0UL && m_input->good() == true;)
+            if (m_input->get() == Cfg::Symbol::Row)
+              --skipLines;
+
+          auto buffer{std::make_unique<char[]>(InputSize)};
+          bool inQuote{false};
+          bool closedQuote{false};
+
+          while (m_input->good() == true)
+          {
+            m_input->read(buffer.get(), InputSize);
+            const char* cursor{buffer.get()};
+            const char* end{cursor + m_input->gcount()};
+
+            while (cursor < end)
+            {
+              if (inQuote == true)
+              {
+                const void* stop{std::memchr(cursor, Cfg::Symbol::Escape, end - cursor)};
+
+                if (stop == nullptr)
+                {
+                  batch->text.append(cursor, end);
+                  cursor = end;
+                }
+                else
+                {
+                  batch->text.append(cursor, static_cast<const char*>(stop));
+                  cursor = static_cast<const char*>(stop) + 1;
+                  inQuote = false;
+                  closedQuote = true;
+                }
+
+                continue;
+              }
+
+              /* An Escape right after the closing one is a literal Escape, the field stays escaped */
+              if (closedQuote == true)
+              {
+                closedQuote = false;
+
+                if (*cursor == Cfg::Symbol::Escape)
+                {
+                  batch->text.push_back(Cfg::Symbol::Escape);
+                  inQuote = true;
+                  ++cursor;
+                  continue;
+                }
+              }
+
+              const char* stop{cursor};
+
+              while (stop < end && special[static_cast<unsigned char>(*stop)] == false)
+                ++stop;
+
+              batch->text.append(cursor, stop);
+              cursor = stop;
+
+              if (cursor == end)
+                break;
+
+              if (*cursor == Cfg::Symbol::Escape)
+                inQuote = true;
+              else if (*cursor == Cfg::Symbol::Column)
+                batch->fieldEnds.push_back(static_cast<uint32_t>(batch->text.size()));
+              else
+              {
+                batch->fieldEnds.push_back(static_cast<uint32_t>(batch->text.size()));
+                batch->rowEnds.push_back(static_cast<uint32_t>(batch->fieldEnds.size()));
+                ++row;
+
+                if (batch->text.size() >= BatchBytes)
+                {
+                  if (dispatch(batch, sequence) == false || m_free.pop(batch) == false)
+                    return;
+
+                  batch->reset(row);
+                }
+              }
+
+              ++cursor;
+            }
+          }
+
+          if (inQuote == true)
+            throw err::FormatError{fmt::format(
+                  "\033[1;35m[ERROR]\033[0m Unpaired escape character.\n"
+                  "\033[1;35m[MESSAGE]\033[0m The escape string should be : {}str{}\n"
+                  "\033[1;35m[MESSAGE]\033[0m Parse error position : <Row:{}>"
+                  , std::to_underlying(Cfg::Symbol::Escape)
+                  , std::to_underlying(Cfg::Symbol::Escape)
+                  , row)};
+
+          size_t lastField{batch->rowEnds.empty() == true ? 0UL : batch->rowEnds.back()};
+          size_t lastText{lastField == 0UL ? 0UL : batch->fieldEnds[lastField - 1UL]};
+
+          /* The final row may be missing its terminating Row symbol */
+          if (batch->fieldEnds.size() > lastField || batch->text.size() > lastText)
+          {
+            batch->fieldEnds.push_back(static_cast<uint32_t>(batch->text.size()));
+            batch->rowEnds.push_back(static_cast<uint32_t>(batch->fieldEnds.size()));
+          }
+        }
+        catch (...)
+        {
+          batch->error = std::current_exception();
+        }
+
+        if (batch->rowEnds.empty() == false || batch->error != nullptr)
+          static_cast<void>(dispatch(batch, sequence));
+
+        for (auto& worker : m_workers)
+          worker->input.close();
+      }
+
+      [[nodiscard]] std::string position(const Batch& batch, size_t row, size_t field) const
+      {
+        size_t firstField{row == 0UL ? 0UL : batch.rowEnds[row - 1UL]};
+        size_t rowBegin{firstField == 0UL ? 0UL : batch.fieldEnds[firstField - 1UL]};
+        size_t begin{field == 0UL ? 0UL : batch.fieldEnds[field - 1UL]};
+
+        return fmt::format("<Row:{};Column:{}-{}>"
+                           , batch.firstRow + row
+                           , begin - rowBegin + 1UL
+                           , batch.fieldEnds[field] - rowBegin + 1UL);
+      }
+
+      template<size_t current>
+      void convertField(Batch& batch, size_t row, size_t field)
+      {
+        size_t begin{field == 0UL ? 0UL : batch.fieldEnds[field - 1UL]};
+        std::string_view view{batch.text.data() + begin, batch.fieldEnds[field] - begin};
+        auto& value{std::get<current>(batch.rows[row])};
+
+        if (view.empty() == true)
+          throw err::FormatError{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Invalid column size.\n"
+                "\033[1;35m[MESSAGE]\033[0m Parse error position : {}"
+                , position(batch, row, field))};
+
+        if (FieldTraits<std::remove_reference_t<decltype(value)>>::parse(view, value) == false)
+          throw err::FormatError{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Invalid data type.\n"
+                "\033[1;35m[MESSAGE]\033[0m The expected type was : {}\n"
+                "\033[1;35m[MESSAGE]\033[0m Parse error position : {}"
+                , boost::typeindex::type_id<decltype(value)>().pretty_name()
+                , position(batch, row, field))};
+
+        if constexpr (ValidatesUtf8<Cfg> == true && std::is_same_v<std::remove_reference_t<decltype(value)>, std::string> == true)
+        {
+          size_t offset{validateUtf8(view)};
+
+          if (offset != std::string_view::npos)
+            throw err::FormatError{fmt::format(
+                  "\033[1;35m[ERROR]\033[0m Invalid UTF-8 sequence.\n"
+                  "\033[1;35m[MESSAGE]\033[0m Byte offset in field : {}\n"
+                  "\033[1;35m[MESSAGE]\033[0m Parse error position : {}"
+                  , offset
+                  , position(batch, row, field))};
+        }
+      }
+
+      template<size_t... Indices>
+      void convertRow(Batch& batch, size_t row, size_t firstField, std::index_sequence<Indices...>)
+      {
+        (convertField<Indices>(batch, row, firstField + Indices), ...);
+      }
+
+      void convertBatch(Batch& batch) noexcept
+      {
+        if (batch.rows.size() < batch.rowEnds.size())
+          batch.rows.resize(batch.rowEnds.size());
+
+        size_t firstField{};
+
+        try
+        {
+          for (; batch.count < batch.rowEnds.size(); ++batch.count)
+          {
+            if (batch.rowEnds[batch.count] - firstField != sizeof...(Types))
+              throw err::FormatError{fmt::format(
+                    "\033[1;35m[ERROR]\033[0m Invalid column size.\n"
+                    "\033[1;35m[MESSAGE]\033[0m Expected {} columns, found {}\n"
+                    "\033[1;35m[MESSAGE]\033[0m Parse error position : <Row:{}>"
+                    , sizeof...(Types)
+                    , batch.rowEnds[batch.count] - firstField
+                    , batch.firstRow + batch.count)};
+
+            convertRow(batch, batch.count, firstField, std::index_sequence_for<Types...>{});
+            firstField = batch.rowEnds[batch.count];
+          }
+        }
+        catch (...)
+        {
+          /* A conversion error always precedes a scanner error stored in the same batch */
+          batch.error = std::current_exception();
+        }
+      }
+
+      void convert(Worker& worker) noexcept
+      {
+        BatchPtr batch;
+
+        while (worker.input.pop(batch) == true)
+        {
+          convertBatch(*batch);
+
+          if (worker.output.push(std::move(batch)) == false)
+            break;
+        }
+
+        worker.output.close();
+      }
+
+      void advance()
+      {
+        if (m_current != nullptr && ++m_index < m_current->count)
+          return;
+
+        for (;;)
+        {
+          if (m_current != nullptr)
+          {
+            if (m_current->error != nullptr)
+            {
+              m_done = true;
+              std::rethrow_exception(m_current->error);
+            }
+
+            static_cast<void>(m_free.push(std::move(m_current)));
+          }
+
+          Worker& worker{*m_workers[m_sequence++ % m_workers.size()]};
+
+          if (worker.output.pop(m_current) == false)
+          {
+            m_done = true;
+            return;
+          }
+
+          m_index = 0UL;
+
+          if (m_current->count != 0UL)
+            return;
+        }
+      }
+
+    public:
+      /**
+       * @brief Input iterator over the converted rows
+       *
+       * @class Iterator
+       */
+      class Iterator
+      {
+      private:
+        PipelineParser* m_parser;
+
+      public:
+        explicit Iterator(PipelineParser* parser) noexcept
+          : m_parser{parser}
+        {}
+
+        [[nodiscard]] std::tuple<Types...>& operator*() noexcept
+        {
+          return m_parser->m_current->rows[m_parser->m_index];
+        }
+
+        Iterator& operator++()
+        {
+          if (m_parser->m_done == false)
+            m_parser->advance();
+
+          return *this;
+        }
+
+        [[nodiscard]] bool operator==(const Iterator& other) const noexcept
+        {
+          return m_parser == other.m_parser && m_parser->m_done == true;
+        }
+
+        [[nodiscard]] bool operator!=(const Iterator& other) const noexcept
+        {
+          return !(*this == other);
+        }
+      };
+
+    public:
+      /**
+       * @brief PipelineParser constructor
+       *
+       * @param [in] in Input stream representing file to parse
+       * @param [in] skipLines The number of lines to skip
+       * @param [in] workers The number of conversion threads (clamped to [1, MaxWorkers])
+       *
+       * @throws invalid_argument
+       */
+      PipelineParser(std::istream& in, size_t skipLines, size_t workers = std::thread::hardware_concurrency() - 1U)
+        : m_input{&in}
+        , m_skipLines{skipLines}
+        , m_index{0UL}
+        , m_sequence{0UL}
+        , m_started{false}
+        , m_done{false}
+      {
+        if (in.good() == false)
+          throw err::InvalidArgument{"\033[1;35m[ERROR]\033[0m Invalid file stream.\n"
+                                     "\033[1;35m[MESSAGE]\033[0m Cannot parse the file."};
+
+        workers = std::clamp(workers, 1UL, MaxWorkers);
+
+        for (size_t i{}; i < (workers + 1UL) * QueueDepth; ++i)
+        {
+          auto batch{std::make_unique<Batch>()};
+          static_cast<void>(m_free.tryPush(batch));
+        }
+
+        for (size_t i{}; i < workers; ++i)
+          m_workers.push_back(std::make_unique<Worker>());
+
+        for (auto& worker : m_workers)
+          worker->thread = std::thread{&PipelineParser::convert, this, std::ref(*worker)};
+
+        m_scanner = std::thread{&PipelineParser::scan, this};
+      }
+
+      PipelineParser(const PipelineParser&) = delete;
+      PipelineParser(PipelineParser&&) = delete;
+
+      ~PipelineParser()
+      {
+        m_free.close();
+
+        for (auto& worker : m_workers)
+        {
+          worker->input.close();
+          worker->output.close();
+        }
+
+        m_scanner.join();
+
+        for (auto& worker : m_workers)
+          worker->thread.join();
+      }
+
+      /**
+       * @brief Begin method for creating Input Iterator
+       *
+       * @throws format_error
+       */
+      [[nodiscard]] Iterator begin()
+      {
+        if (m_started == false)
+        {
+          m_started = true;
+          advance();
+        }
+
+        return Iterator{this};
+      }
+
+      /**
+       * @brief End method for creating Input Iterator
+       */
+      [[nodiscard]] Iterator end() noexcept
+      {
+        return Iterator{this};
+      }
+
+      /**
+       * @brief Lazy view over the converted rows for use with std::ranges adaptors
+       *
+       * The parser must outlive the returned generator.
+       *
+       * @throws format_error (while iterating)
+       */
+      [[nodiscard]] Generator<std::tuple<Types...>&> rows()
+      {
+        for (auto&& row : *this)
+          co_yield row;
+      }
+
+      /**
+       * @brief Lazy view over whole converted batches, suspending once per batch
+       *
+       * A span stays valid until the generator is resumed.
+       *
+       * @throws format_error (while iterating)
+       */
+      [[nodiscard]] Generator<std::span<std::tuple<Types...>>> batches()
+      {
+        if (m_started == false)
+        {
+          m_started = true;
+          advance();
+        }
+
+        while (m_done == false)
+        {
+          co_yield std::span<std::tuple<Types...>>{m_current->rows.data() + m_index, m_current->count - m_index};
+
+          /* Skip the rest of the batch so advance() fetches the next one */
+          m_index = m_current->count - 1UL;
+          advance();
+        }
+      }
+
+      PipelineParser& operator=(const PipelineParser&) = delete;
+      PipelineParser& operator=(PipelineParser&&) = delete;
+    };
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End pipeline header file */
@@ -0,0 +1,380 @@
+#ifndef NOP_CSV_PROFILE_HPP   /* Begin profile header file */
+#define NOP_CSV_PROFILE_HPP 1
+
+#include <tuple>
+#include <array>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <cstdint>
+#include <boost/type_index.hpp>
+#include <fmt/format.h>
+#include "exception.hpp"
+#include "convert.hpp"
+#include "sketch.hpp"
+#include "tokenizer.hpp"
+#include "ingest.hpp"
+#include "thread_pool.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Statistics of one column
+     *
+     * @class ColumnProfile
+     *
+     * @tparam T Column type, values are converted with FieldTraits<T>
+     *
+     * Empty fields count as nulls and fields FieldTraits<T> rejects as invalid.
+     * Arithmetic values are gathered in small batches whose minimum and
+     * maximum are reduced in one branch-free loop the compiler vectorizes.
+     * Every member merges, so chunks can be profiled independently.
+     */
+    template<ConvertibleField T>
+    class ColumnProfile
+    {
+    private:
+      static constexpr size_t BatchSize{256UL};
+      static constexpr bool Batched{std::is_arithmetic_v<T> == true};
+
+    private:
+      uint64_t m_count;
+      uint64_t m_nulls;
+      uint64_t m_invalid;
+      std::optional<T> m_min;
+      std::optional<T> m_max;
+      HyperLogLog m_distinct;
+      LengthHistogram m_lengths;
+      std::array<T, Batched == true ? BatchSize : 1UL> m_batch;
+      size_t m_batchSize;
+      T m_value;
+
+    private:
+      void extend(const T& low, const T& high)
+      {
+        if (m_min.has_value() == false || low < *m_min)
+          m_min = low;
+
+        if (m_max.has_value() == false || *m_max < high)
+          m_max = high;
+      }
+
+      void flush() noexcept
+      {
+        if (m_batchSize == 0UL)
+          return;
+
+        T low{m_batch[0]};
+        T high{m_batch[0]};
+
+        for (size_t i{1UL}; i < m_batchSize; ++i)
+        {
+          low = std::min(low, m_batch[i]);
+          high = std::max(high, m_batch[i]);
+        }
+
+        m_batchSize = 0UL;
+        extend(low, high);
+      }
+
+    public:
+      ColumnProfile() noexcept
+        : m_count{0UL}
+        , m_nulls{0UL}
+        , m_invalid{0UL}
+        , m_batch{}
+        , m_batchSize{0UL}
+        , m_value{}
+      {}
+
+      /**
+       * @brief Adds one unescaped field
+       */
+      void add(std::string_view field)
+      {
+        ++m_count;
+        m_lengths.add(field.size());
+
+        if (field.empty() == true)
+        {
+          ++m_nulls;
+          return;
+        }
+
+        m_distinct.add(HyperLogLog::hash(field));
+
+        if (FieldTraits<T>::parse(field, m_value) == false)
+        {
+          ++m_invalid;
+          return;
+        }
+
+        if constexpr (Batched == true)
+        {
+          m_batch[m_batchSize++] = m_value;
+
+          if (m_batchSize == BatchSize)
+            flush();
+        }
+        else
+          extend(m_value, m_value);
+      }
+
+      void merge(ColumnProfile& other)
+      {
+        flush();
+        other.flush();
+        m_count += other.m_count;
+        m_nulls += other.m_nulls;
+        m_invalid += other.m_invalid;
+        m_distinct.merge(other.m_distinct);
+        m_lengths.merge(other.m_lengths);
+
+        if (other.m_min.has_value() == true)
+          extend(*other.m_min, *other.m_max);
+      }
+
+      [[nodiscard]] uint64_t count() const noexcept
+      {
+        return m_count;
+      }
+
+      [[nodiscard]] uint64_t nulls() const noexcept
+      {
+        return m_nulls;
+      }
+
+      [[nodiscard]] uint64_t invalid() const noexcept
+      {
+        return m_invalid;
+      }
+
+      [[nodiscard]] const std::optional<T>& min()
+      {
+        flush();
+        return m_min;
+      }
+
+      [[nodiscard]] const std::optional<T>& max()
+      {
+        flush();
+        return m_max;
+      }
+
+      [[nodiscard]] double distinct() const noexcept
+      {
+        return m_distinct.estimate();
+      }
+
+      [[nodiscard]] const LengthHistogram& lengths() const noexcept
+      {
+        return m_lengths;
+      }
+    };
+
+    /**
+     * @brief One pass per-column profiler of csv text
+     *
+     * @class Profiler
+     *
+     * @tparam Cfg Configuration class that consists of char enum providing symbols
+     * @tparam Types... Column types
+     */
+    template<class Cfg, ConvertibleField... Types>
+    class Profiler
+    {
+    public:
+      static constexpr size_t BlockSize{1UL << 20};
+
+    private:
+      static constexpr size_t Columns{sizeof...(Types)};
+
+    private:
+      std::tuple<ColumnProfile<Types>...> m_columns;
+      uint64_t m_rows;
+      RowSplitter<Cfg> m_splitter;
+
+    private:
+      template<size_t... Indices>
+      void addRow(std::index_sequence<Indices...>)
+      {
+        (std::get<Indices>(m_columns).add(m_splitter.fields()[Indices]), ...);
+        ++m_rows;
+      }
+
+      template<size_t... Indices>
+      void mergeColumns(Profiler& other, std::index_sequence<Indices...>)
+      {
+        (std::get<Indices>(m_columns).merge(std::get<Indices>(other.m_columns)), ...);
+      }
+
+      template<size_t Index>
+      void reportColumn(std::string& text)
+      {
+        using Type = std::tuple_element_t<Index, std::tuple<Types...>>;
+
+        auto& column{std::get<Index>(m_columns)};
+
+        auto value{[](const std::optional<Type>& value) -> std::string
+        {
+          if (value.has_value() == false)
+            return "-";
+
+          if constexpr (std::is_arithmetic_v<Type> == true || std::is_convertible_v<const Type&, std::string_view> == true)
+            return fmt::format("{}", *value);
+          else
+          {
+            char buffer[64];
+            return std::string{buffer, FieldTraits<Type>::format(buffer, buffer + sizeof(buffer), *value)};
+          }
+        }};
+
+        text += fmt::format("Column {} ({}): count {}, nulls {}, invalid {}, min {}, max {}, distinct ~{:.0f}\n"
+                            "  lengths: {}\n"
+                            , Index + 1UL
+                            , boost::typeindex::type_id<Type>().pretty_name()
+                            , column.count()
+                            , column.nulls()
+                            , column.invalid()
+                            , value(column.min())
+                            , value(column.max())
+                            , column.distinct()
+                            , column.lengths().format());
+      }
+
+    public:
+      Profiler()
+        : m_rows{0UL}
+        , m_splitter{Columns}
+      {}
+
+      /**
+       * @brief Profiles the complete rows of text
+       *
+       * @param [in] text Csv text
+       * @param [in] last Whether text ends the input (a final row needs no Row symbol)
+       *
+       * @return Number of consumed bytes, the cut off last row is left for the next call
+       *
+       * @throws format_error
+       */
+      size_t consume(std::string_view text, bool last)
+      {
+        size_t position{};
+
+        while (position < text.size())
+        {
+          size_t next{m_splitter.split(text, position, last, m_rows)};
+
+          if (next == std::string_view::npos)
+            break;
+
+          addRow(std::index_sequence_for<Types...>{});
+          position = next;
+        }
+
+        return position;
+      }
+
+      /**
+       * @brief Profiles a stream block by block
+       *
+       * @param [in] in Input stream
+       * @param [in] skipLines Lines skipped first
+       * @param [in] limit Number of bytes to read at most
+       *
+       * @throws format_error, invalid_argument
+       */
+      void consume(std::istream& in, size_t skipLines, uint64_t limit = UINT64_MAX)
+      {
+        BlockReader<Cfg> reader{in, skipLines, limit, BlockSize};
+
+        for (size_t consumed{}; reader.read(consumed) == true;)
+          consumed = consume(reader.text(), reader.last());
+      }
+
+      /**
+       * @brief Adds the statistics of another profiler
+       */
+      void merge(Profiler& other)
+      {
+        mergeColumns(other, std::index_sequence_for<Types...>{});
+        m_rows += other.m_rows;
+      }
+
+      [[nodiscard]] uint64_t rows() const noexcept
+      {
+        return m_rows;
+      }
+
+      template<size_t Index>
+      [[nodiscard]] auto& column() noexcept
+      {
+        return std::get<Index>(m_columns);
+      }
+
+      /**
+       * @brief Human readable summary, one block per column
+       */
+      [[nodiscard]] std::string report()
+      {
+        std::string text{fmt::format("Rows: {}\n", m_rows)};
+
+        [&]<size_t... Indices>(std::index_sequence<Indices...>)
+        {
+          (reportColumn<Indices>(text), ...);
+        }(std::index_sequence_for<Types...>{});
+
+        return text;
+      }
+    };
+
+    /**
+     * @brief Profiles chunks of files in parallel and merges the results
+     *
+     * @param [in] chunks Tasks produced by splitFiles
+     * @param [in] skipLines Lines skipped at the start of every file
+     * @param [in] pool Pool the chunks are profiled on
+     *
+     * @throws format_error, invalid_argument
+     */
+    template<class Cfg, ConvertibleField... Types>
+    [[nodiscard]] Profiler<Cfg, Types...> profileFiles(const std::vector<FileChunk>& chunks, size_t skipLines, ThreadPool& pool)
+    {
+      Profiler<Cfg, Types...> result;
+      std::mutex lock;
+
+      for (const auto& chunk : chunks)
+        pool.submit([&chunk, &result, &lock, skipLines]
+        {
+          Profiler<Cfg, Types...> profiler;
+
+          consumeChunk(chunk, skipLines, [&profiler](std::istream& in, size_t skip, uint64_t limit)
+          {
+            profiler.consume(in, skip, limit);
+          });
+
+          std::lock_guard<std::mutex> guard{lock};
+          result.merge(profiler);
+        });
+
+      pool.wait();
+      return result;
+    }
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End profile header file */
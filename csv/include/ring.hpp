@@ -0,0 +1,164 @@
+#ifndef NOP_CSV_RING_HPP   /* Begin ring header file */
+#define NOP_CSV_RING_HPP 1
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <utility>
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Bounded lock-free ring for exactly one producer and one consumer thread
+     *
+     * @class SpscRing
+     *
+     * @tparam T Element type (must be default constructible and move assignable)
+     * @tparam Capacity Number of slots, must be a power of two
+     *
+     * The fast path is a pair of acquire/release index updates. Blocking push/pop
+     * sleep on a shared signal word that is bumped by every state change, so a
+     * close() from either side always wakes the opposite thread.
+     */
+    template<typename T, size_t Capacity>
+    class SpscRing
+    {
+      static_assert(Capacity != 0UL && (Capacity & (Capacity - 1UL)) == 0UL,
+                    "SpscRing capacity must be a power of two");
+
+    private:
+      alignas(64) std::atomic<size_t> m_head;
+      alignas(64) std::atomic<size_t> m_tail;
+      alignas(64) std::atomic<uint32_t> m_signal;
+      std::atomic<bool> m_closed;
+      std::array<T, Capacity> m_slots;
+
+    private:
+      void signal() noexcept
+      {
+        m_signal.fetch_add(1U, std::memory_order_release);
+        m_signal.notify_all();
+      }
+
+    public:
+      SpscRing()
+        : m_head{0UL}
+        , m_tail{0UL}
+        , m_signal{0U}
+        , m_closed{false}
+        , m_slots{}
+      {}
+
+      SpscRing(const SpscRing&) = delete;
+      SpscRing(SpscRing&&) = delete;
+      ~SpscRing() = default;
+
+      /**
+       * @brief Non-blocking push, called only by the producer
+       *
+       * @return false if the ring is full
+       */
+      [[nodiscard]] bool tryPush(T& value) noexcept(std::is_nothrow_move_assignable_v<T>)
+      {
+        size_t head{m_head.load(std::memory_order_relaxed)};
+
+        if (head - m_tail.load(std::memory_order_acquire) == Capacity)
+          return false;
+
+        m_slots[head & (Capacity - 1UL)] = std::move(value);
+        m_head.store(head + 1UL, std::memory_order_release);
+        return true;
+      }
+
+      /**
+       * @brief Non-blocking pop, called only by the consumer
+       *
+       * @return false if the ring is empty
+       */
+      [[nodiscard]] bool tryPop(T& value) noexcept(std::is_nothrow_move_assignable_v<T>)
+      {
+        size_t tail{m_tail.load(std::memory_order_relaxed)};
+
+        if (m_head.load(std::memory_order_acquire) == tail)
+          return false;
+
+        value = std::move(m_slots[tail & (Capacity - 1UL)]);
+        m_tail.store(tail + 1UL, std::memory_order_release);
+        return true;
+      }
+
+      /**
+       * @brief Blocking push, waits while the ring is full
+       *
+       * @return false if the ring was closed before the value could be stored
+       */
+      [[nodiscard]] bool push(T&& value)
+      {
+        for (;;)
+        {
+          uint32_t observed{m_signal.load(std::memory_order_acquire)};
+
+          if (m_closed.load(std::memory_order_acquire) == true)
+            return false;
+
+          if (tryPush(value) == true)
+          {
+            signal();
+            return true;
+          }
+
+          m_signal.wait(observed, std::memory_order_acquire);
+        }
+      }
+
+      /**
+       * @brief Blocking pop, waits while the ring is empty
+       *
+       * @return false once the ring is closed and fully drained
+       */
+      [[nodiscard]] bool pop(T& value)
+      {
+        for (;;)
+        {
+          uint32_t observed{m_signal.load(std::memory_order_acquire)};
+
+          if (tryPop(value) == true)
+          {
+            signal();
+            return true;
+          }
+
+          if (m_closed.load(std::memory_order_acquire) == true)
+            return tryPop(value);
+
+          m_signal.wait(observed, std::memory_order_acquire);
+        }
+      }
+
+      /**
+       * @brief Marks the end of the stream and wakes both sides
+       */
+      void close() noexcept
+      {
+        m_closed.store(true, std::memory_order_release);
+        signal();
+      }
+
+      [[nodiscard]] bool isClosed() const noexcept
+      {
+        return m_closed.load(std::memory_order_acquire);
+      }
+
+      SpscRing& operator=(const SpscRing&) = delete;
+      SpscRing& operator=(SpscRing&&) = delete;
+    };
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End ring header file */
@@ -0,0 +1,266 @@
+#ifndef NOP_CSV_SCHEMA_HPP   /* Begin schema header file */
+#define NOP_CSV_SCHEMA_HPP 1
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <istream>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <fmt/format.h>
+#include "exception.hpp"
+#include "datetime.hpp"
+#include "tokenizer.hpp"
+#include "generator.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Column types known to schema inference, narrowest first
+     */
+    enum class ColumnType : uint8_t
+    {
+      Int64,
+      Bool,
+      Double,
+      Timestamp,
+      String
+    };
+
+    /**
+     * @brief Value of a field whose type is only known at runtime
+     *
+     * Empty fields of non-string columns hold std::monostate.
+     */
+    using Value = std::variant<std::monostate, int64_t, bool, double, Timestamp, std::string>;
+
+    /**
+     * @brief Converts one field into a Value, false if the field does not fit the column type
+     */
+    using Kernel = bool (*)(std::string_view, Value&);
+
+    [[nodiscard]] std::string_view typeName(ColumnType) noexcept;
+
+    /**
+     * @brief Precompiled conversion kernel of a column type
+     */
+    [[nodiscard]] Kernel kernel(ColumnType) noexcept;
+
+    /**
+     * @brief Bit set of the column types (1 << type) that accept a non-empty field
+     */
+    [[nodiscard]] uint32_t acceptedTypes(std::string_view) noexcept;
+
+    /**
+     * @brief Narrowest type of a set produced by acceptedTypes (String is always accepted)
+     */
+    [[nodiscard]] inline ColumnType narrowestType(uint32_t accepted) noexcept
+    {
+      return static_cast<ColumnType>(std::countr_zero(accepted));
+    }
+
+    /**
+     * @brief Infers column types from the rows of a sample
+     *
+     * @tparam Cfg Configuration class that consists of char enum providing symbols
+     *
+     * @param [in] sample Csv text starting at a row, the first row decides the number of columns
+     * @param [in] last Whether sample ends the input, otherwise its cut off last row is ignored
+     *
+     * Every column gets the narrowest type accepting all of its non-empty
+     * sampled fields; columns without any get String. An empty sample has
+     * no columns.
+     *
+     * @throws format_error
+     */
+    template<class Cfg>
+    [[nodiscard]] std::vector<ColumnType> inferSchema(std::string_view sample, bool last)
+    {
+      if (sample.empty() == true)
+        return {};
+
+      const size_t columns{RowSplitter<Cfg>::countColumns(sample)};
+      constexpr uint32_t AllTypes{(1U << (static_cast<uint32_t>(ColumnType::String) + 1U)) - 1U};
+
+      RowSplitter<Cfg> splitter{columns};
+      std::vector<uint32_t> accepted(columns, AllTypes);
+      std::vector<bool> seen(columns, false);
+      size_t position{};
+
+      for (uint64_t row{}; position < sample.size(); ++row)
+      {
+        size_t next{splitter.split(sample, position, last, row)};
+
+        if (next == std::string_view::npos)
+          break;
+
+        for (size_t column{}; column < columns; ++column)
+        {
+          std::string_view field{splitter.fields()[column]};
+
+          /* Nothing narrower than String remains to be ruled out */
+          if (field.empty() == true || accepted[column] == 1U << static_cast<uint32_t>(ColumnType::String))
+            continue;
+
+          accepted[column] &= acceptedTypes(field);
+          seen[column] = true;
+        }
+
+        position = next;
+      }
+
+      std::vector<ColumnType> schema(columns);
+
+      for (size_t column{}; column < columns; ++column)
+        schema[column] = seen[column] == true ? narrowestType(accepted[column]) : ColumnType::String;
+
+      return schema;
+    }
+
+    /**
+     * @brief Parser of csv files with a schema inferred at runtime
+     *
+     * @class DynamicParser
+     *
+     * @tparam Cfg Configuration class that consists of char enum providing symbols
+     *
+     * The column types are inferred from the first sampleSize bytes, then
+     * every column is converted by the precompiled kernel of its type, so no
+     * per-field type dispatch is left on the hot path. A field the sample
+     * did not anticipate (e.g. a fraction in an Int64 column) is a format
+     * error. The rows are single-pass ranges like those of Parser.
+     */
+    template<class Cfg>
+    class DynamicParser
+    {
+    public:
+      using Row = std::vector<Value>;
+
+      static constexpr size_t BlockSize{1UL << 20};
+      static constexpr size_t SampleSize{64UL << 10};
+
+    private:
+      BlockReader<Cfg> m_reader;
+      std::vector<ColumnType> m_schema;
+      std::vector<Kernel> m_kernels;
+      RowSplitter<Cfg> m_splitter;
+      Row m_row;
+      uint64_t m_rows;
+      Generator<const Row&> m_generator;
+
+    private:
+      void convert()
+      {
+        const auto& fields{m_splitter.fields()};
+
+        for (size_t column{}; column < m_kernels.size(); ++column)
+          if (m_kernels[column](fields[column], m_row[column]) == false)
+            throw err::FormatError{fmt::format(
+                  "\033[1;35m[ERROR]\033[0m Invalid data type.\n"
+                  "\033[1;35m[MESSAGE]\033[0m The expected (inferred) type was : {}\n"
+                  "\033[1;35m[MESSAGE]\033[0m Parse error position : <Row:{};Column:{}>"
+                  , typeName(m_schema[column])
+                  , m_rows
+                  , column + 1UL)};
+      }
+
+      [[nodiscard]] Generator<const Row&> generate()
+      {
+        if (m_schema.empty() == true)
+          co_return;
+
+        for (;;)
+        {
+          std::string_view text{m_reader.text()};
+          size_t position{};
+
+          while (position < text.size())
+          {
+            size_t next{m_splitter.split(text, position, m_reader.last(), m_rows)};
+
+            if (next == std::string_view::npos)
+              break;
+
+            convert();
+            co_yield m_row;
+            ++m_rows;
+            position = next;
+          }
+
+          if (m_reader.read(position) == false)
+            co_return;
+        }
+      }
+
+    public:
+      /**
+       * @brief DynamicParser constructor, reads the sample and infers the schema
+       *
+       * @param [in] in Input stream
+       * @param [in] skipLines Lines skipped before the sample (e.g. a header)
+       * @param [in] sampleSize Bytes the schema is inferred from
+       *
+       * @throws format_error, invalid_argument
+       */
+      DynamicParser(std::istream& in, size_t skipLines, size_t sampleSize = SampleSize)
+        : m_reader{in, skipLines, UINT64_MAX, std::max(sampleSize, BlockSize)}
+        , m_schema{}
+        , m_kernels{}
+        , m_splitter{0UL}
+        , m_row{}
+        , m_rows{skipLines}
+        , m_generator{}
+      {
+        static_cast<void>(m_reader.read(0UL));
+        std::string_view text{m_reader.text()};
+        std::string_view sample{text.substr(0UL, sampleSize)};
+
+        m_schema = inferSchema<Cfg>(sample, m_reader.last() == true && sample.size() == text.size());
+        m_splitter = RowSplitter<Cfg>{m_schema.size()};
+        m_row.resize(m_schema.size());
+
+        for (const auto& type : m_schema)
+          m_kernels.push_back(kernel(type));
+
+        m_generator = generate();
+      }
+
+      DynamicParser(const DynamicParser&) = delete;
+      DynamicParser(DynamicParser&&) = delete;
+      ~DynamicParser() = default;
+
+      [[nodiscard]] const std::vector<ColumnType>& schema() const noexcept
+      {
+        return m_schema;
+      }
+
+      /**
+       * @brief Parses up to the first row
+       *
+       * @throws format_error
+       */
+      [[nodiscard]] auto begin()
+      {
+        return m_generator.begin();
+      }
+
+      [[nodiscard]] auto end() const noexcept
+      {
+        return m_generator.end();
+      }
+
+      DynamicParser& operator=(const DynamicParser&) = delete;
+      DynamicParser& operator=(DynamicParser&&) = delete;
+    };
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End schema header file */
@@ -0,0 +1,82 @@
+#ifndef NOP_CSV_SKETCH_HPP   /* Begin sketch header file */
+#define NOP_CSV_SKETCH_HPP 1
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Distinct count estimator
+     *
+     * @class HyperLogLog
+     *
+     * 2^Precision one-byte registers keep the longest run of leading zero bits
+     * seen per hash bucket (standard error 1.04 / sqrt(2^Precision), 1.6% here).
+     * Merging is a register-wise maximum, so sketches of separate chunks
+     * combine into exactly the sketch of the whole input.
+     */
+    class HyperLogLog
+    {
+    public:
+      static constexpr uint32_t Precision{12U};
+      static constexpr size_t Registers{1UL << Precision};
+
+    private:
+      std::array<uint8_t, Registers> m_registers;
+
+    public:
+      HyperLogLog() noexcept;
+
+      void add(uint64_t hash) noexcept;
+      void merge(const HyperLogLog&) noexcept;
+
+      [[nodiscard]] double estimate() const noexcept;
+
+      /**
+       * @brief 64-bit hash of a field's text with well mixed high bits
+       */
+      [[nodiscard]] static uint64_t hash(std::string_view) noexcept;
+    };
+
+    /**
+     * @brief Counts of field lengths in power of two buckets
+     *
+     * @class LengthHistogram
+     *
+     * Bucket 0 holds empty fields, bucket b > 0 lengths in [2^(b-1), 2^b) and
+     * the last bucket everything longer.
+     */
+    class LengthHistogram
+    {
+    public:
+      static constexpr size_t Buckets{16UL};
+
+    private:
+      std::array<uint64_t, Buckets> m_counts;
+
+    public:
+      LengthHistogram() noexcept;
+
+      void add(size_t length) noexcept;
+      void merge(const LengthHistogram&) noexcept;
+
+      [[nodiscard]] uint64_t count(size_t bucket) const noexcept;
+
+      /**
+       * @brief Non-empty buckets as "lower-upper:count" pairs
+       */
+      [[nodiscard]] std::string format() const;
+    };
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End sketch header file */
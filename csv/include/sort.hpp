@@ -0,0 +1,262 @@
+#ifndef NOP_CSV_SORT_HPP   /* Begin sort header file */
+#define NOP_CSV_SORT_HPP 1
+
+#include <tuple>
+#include <vector>
+#include <string>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <semaphore>
+#include <type_traits>
+#include "spill.hpp"
+#include "generator.hpp"
+#include "thread_pool.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Tournament tree of losers for k-way merging
+     *
+     * @class LoserTree
+     *
+     * @tparam Less Callable ordering two leaves by index, an exhausted leaf orders last
+     *
+     * Every internal node keeps the loser of the match played there and node 0
+     * the overall winner, so replacing the winner replays a single leaf-to-root
+     * path: log2(k) comparisons per element and no sibling lookups.
+     */
+    template<typename Less>
+    class LoserTree
+    {
+    private:
+      std::vector<size_t> m_tree;
+      Less m_less;
+
+    private:
+      /* Index size() is a virtual leaf that beats every real one, used while building */
+      [[nodiscard]] bool wins(size_t lhs, size_t rhs)
+      {
+        if (lhs == m_tree.size() || rhs == m_tree.size())
+          return lhs == m_tree.size();
+
+        return m_less(lhs, rhs) == true || (m_less(rhs, lhs) == false && lhs < rhs);
+      }
+
+    public:
+      /**
+       * @brief Builds the tree over leaves 0 .. size-1
+       *
+       * @param [in] size Number of leaves (at least one)
+       * @param [in] less Leaf ordering
+       */
+      LoserTree(size_t size, Less less)
+        : m_tree(size, size)
+        , m_less{std::move(less)}
+      {
+        for (size_t leaf{size}; leaf-- > 0UL;)
+          replay(leaf);
+      }
+
+      /**
+       * @brief Index of the smallest leaf
+       */
+      [[nodiscard]] size_t top() const noexcept
+      {
+        return m_tree[0];
+      }
+
+      /**
+       * @brief Restores the tree after the value of a leaf changed
+       */
+      void replay(size_t leaf)
+      {
+        for (size_t node{(leaf + m_tree.size()) / 2UL}; node > 0UL; node /= 2UL)
+          if (wins(m_tree[node], leaf) == true)
+            std::swap(m_tree[node], leaf);
+
+        m_tree[0] = leaf;
+      }
+    };
+
+    /**
+     * @brief External merge sort of typed rows by one key column
+     *
+     * @class ExternalSorter
+     *
+     * @tparam Column Index of the key column
+     * @tparam Types... Column types, arithmetic or std::string
+     *
+     * Rows are gathered until a run's share of the memory budget is reached.
+     * The full run is then stable sorted and spilled on the pool while the
+     * caller keeps pushing rows, and at most pool.size() runs are in flight.
+     * sorted() merges all runs with a LoserTree. Keys compare in their typed
+     * form, so 9 < 10 and 1e3 == 1000. Ties keep input order, so the sort is
+     * stable.
+     */
+    template<size_t Column, SpillableField... Types>
+    class ExternalSorter
+    {
+      static_assert(Column < sizeof...(Types), "Key column is out of range");
+
+    private:
+      using Row = std::tuple<Types...>;
+
+    private:
+      ThreadPool* m_pool;
+      std::string m_directory;
+      size_t m_runBytes;
+      std::vector<Row> m_rows;
+      size_t m_bytes;
+      std::vector<std::unique_ptr<SpillFile>> m_runs;
+      std::counting_semaphore<> m_slots;
+
+    private:
+      [[nodiscard]] static bool less(const Row& lhs, const Row& rhs) noexcept
+      {
+        return std::get<Column>(lhs) < std::get<Column>(rhs);
+      }
+
+      void spill()
+      {
+        m_slots.acquire();
+
+        SpillFile* run{m_runs.emplace_back(std::make_unique<SpillFile>(m_directory.c_str())).get()};
+
+        m_pool->submit([this, run, rows = std::move(m_rows)]() mutable
+        {
+          struct Release
+          {
+            std::counting_semaphore<>& slots;
+
+            ~Release()
+            {
+              slots.release();
+            }
+          } release{m_slots};
+
+          std::stable_sort(rows.begin(), rows.end(), less);
+
+          for (const auto& row : rows)
+            run->writeRow(row);
+        });
+
+        m_rows = {};
+        m_bytes = 0UL;
+      }
+
+    public:
+      /**
+       * @brief ExternalSorter constructor
+       *
+       * @param [in] pool Pool runs are sorted and spilled on
+       * @param [in] memory Memory budget in bytes for rows held by the sorter
+       * @param [in] directory Directory for spilled runs
+       */
+      ExternalSorter(ThreadPool& pool, size_t memory, std::string directory = defaultSpillDirectory())
+        : m_pool{&pool}
+        , m_directory{std::move(directory)}
+        , m_runBytes{std::max(memory / (pool.size() + 1UL), sizeof(Row))}
+        , m_bytes{0UL}
+        , m_slots{static_cast<std::ptrdiff_t>(pool.size())}
+      {}
+
+      ExternalSorter(const ExternalSorter&) = delete;
+      ExternalSorter(ExternalSorter&&) = delete;
+
+      /* Spill tasks refer to this sorter */
+      ~ExternalSorter()
+      {
+        try
+        {
+          m_pool->wait();
+        }
+        catch (...)
+        {}
+      }
+
+      /**
+       * @brief Adds one row
+       *
+       * @throws system_error if a run cannot be spilled
+       */
+      void push(Row&& row)
+      {
+        m_bytes += footprint(row);
+        m_rows.push_back(std::move(row));
+
+        if (m_bytes >= m_runBytes)
+          spill();
+      }
+
+      void push(const Row& row)
+      {
+        push(Row{row});
+      }
+
+      /**
+       * @brief Lazy view over all pushed rows ordered by the key column
+       *
+       * Must be called once, after the last push. Input that fits in one run
+       * is sorted in memory and never touches the disk.
+       *
+       * @throws system_error (while iterating)
+       */
+      [[nodiscard]] Generator<Row&> sorted()
+      {
+        if (m_runs.empty() == true)
+        {
+          std::stable_sort(m_rows.begin(), m_rows.end(), less);
+
+          for (auto& row : m_rows)
+            co_yield row;
+
+          co_return;
+        }
+
+        if (m_rows.empty() == false)
+          spill();
+
+        m_pool->wait();
+
+        std::vector<Row> heads(m_runs.size());
+        std::vector<bool> exhausted(m_runs.size());
+
+        for (size_t run{}; run < m_runs.size(); ++run)
+        {
+          m_runs[run]->rewind();
+          exhausted[run] = m_runs[run]->readRow(heads[run]) == false;
+        }
+
+        /* Equal keys fall back to the run index, which is the input order */
+        LoserTree tree{m_runs.size(), [&](size_t lhs, size_t rhs)
+        {
+          if (exhausted[lhs] == true || exhausted[rhs] == true)
+            return exhausted[rhs] == true && exhausted[lhs] == false;
+
+          return less(heads[lhs], heads[rhs]);
+        }};
+
+        for (size_t run{tree.top()}; exhausted[run] == false; run = tree.top())
+        {
+          co_yield heads[run];
+          exhausted[run] = m_runs[run]->readRow(heads[run]) == false;
+          tree.replay(run);
+        }
+
+        m_runs.clear();
+      }
+
+      ExternalSorter& operator=(const ExternalSorter&) = delete;
+      ExternalSorter& operator=(ExternalSorter&&) = delete;
+    };
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End sort header file */
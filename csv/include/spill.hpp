@@ -0,0 +1,163 @@
+#ifndef NOP_CSV_SPILL_HPP   /* Begin spill header file */
+#define NOP_CSV_SPILL_HPP 1
+
+#include <tuple>
+#include <string>
+#include <memory>
+#include <utility>
+#include <cstdio>
+#include <cstdint>
+#include <type_traits>
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Column types a spill file can hold
+     */
+    template<typename T>
+    concept SpillableField = (std::is_trivially_copyable_v<T> == true || std::is_same_v<T, std::string> == true);
+
+    /**
+     * @brief Approximate heap and inline bytes held by a row
+     */
+    template<SpillableField... Types>
+    [[nodiscard]] size_t footprint(const std::tuple<Types...>& row) noexcept
+    {
+      return std::apply([](const auto&... fields)
+      {
+        return (sizeof(std::tuple<Types...>) + ... + [](const auto& field) -> size_t
+        {
+          if constexpr (std::is_same_v<std::remove_cvref_t<decltype(field)>, std::string> == true)
+            return field.capacity();
+          else
+            return 0UL;
+        }(fields));
+      }, row);
+    }
+
+    /**
+     * @brief Anonymous binary scratch file for rows that do not fit in memory
+     *
+     * @class SpillFile
+     *
+     * The file is unlinked right after creation, so it never outlives the
+     * process. Trivially copyable fields (arithmetic, dates, timestamps) are
+     * stored as raw bytes and strings as a 64-bit length followed by their
+     * bytes: reading a row back costs no parsing at all.
+     */
+    class SpillFile
+    {
+    public:
+      static constexpr size_t BufferSize{1UL << 18};
+
+    private:
+      std::FILE* m_file;
+      std::unique_ptr<char[]> m_buffer;
+
+    private:
+      void write(const void*, size_t);
+      [[nodiscard]] bool read(void*, size_t);
+
+      template<typename T>
+      void writeField(const T& value)
+      {
+        if constexpr (std::is_same_v<T, std::string> == true)
+        {
+          uint64_t size{value.size()};
+          write(&size, sizeof(size));
+          write(value.data(), value.size());
+        }
+        else
+          write(&value, sizeof(value));
+      }
+
+      template<typename T>
+      [[nodiscard]] bool readField(T& value)
+      {
+        if constexpr (std::is_same_v<T, std::string> == true)
+        {
+          uint64_t size{};
+
+          if (read(&size, sizeof(size)) == false)
+            return false;
+
+          value.resize(size);
+          return size == 0UL || read(value.data(), size) == true;
+        }
+        else
+          return read(&value, sizeof(value));
+      }
+
+      [[noreturn]] void corrupted() const;
+
+    public:
+      /**
+       * @brief Creates the scratch file
+       *
+       * @param [in] directory Directory the file is created in
+       *
+       * @throws system_error
+       */
+      explicit SpillFile(const char* directory);
+      SpillFile(const SpillFile&) = delete;
+      SpillFile(SpillFile&&) = delete;
+      ~SpillFile();
+
+      /**
+       * @brief Appends one row
+       *
+       * @throws system_error
+       */
+      template<SpillableField... Types>
+      void writeRow(const std::tuple<Types...>& row)
+      {
+        std::apply([this](const auto&... fields) { (writeField(fields), ...); }, row);
+      }
+
+      /**
+       * @brief Reads the next row
+       *
+       * @return false once every row was read
+       *
+       * @throws system_error if the file ends inside a row
+       */
+      template<SpillableField... Types>
+      [[nodiscard]] bool readRow(std::tuple<Types...>& row)
+      {
+        return std::apply([this](auto& first, auto&... rest)
+        {
+          if (readField(first) == false)
+            return false;
+
+          if ((readField(rest) && ...) == false)
+            corrupted();
+
+          return true;
+        }, row);
+      }
+
+      /**
+       * @brief Flushes pending writes and moves back to the first row
+       *
+       * @throws system_error
+       */
+      void rewind();
+
+      SpillFile& operator=(const SpillFile&) = delete;
+      SpillFile& operator=(SpillFile&&) = delete;
+    };
+
+    /**
+     * @brief Directory for spill files: $TMPDIR, or /tmp when it is unset
+     */
+    [[nodiscard]] const char* defaultSpillDirectory() noexcept;
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End spill header file */
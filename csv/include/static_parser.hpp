@@ -0,0 +1,236 @@
+#ifndef NOP_CSV_STATIC_PARSER_HPP   /* Begin static parser header file */
+#define NOP_CSV_STATIC_PARSER_HPP 1
+
+#include <tuple>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <type_traits>
+#include "NOP/container/array/array.hpp"
+#include "exception.hpp"
+#include "convert.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief String literal usable as a template argument
+     *
+     * @struct FixedString
+     *
+     * @tparam Size Literal size including the terminating null
+     */
+    template<size_t Size>
+    struct FixedString
+    {
+    public:
+      char value[Size]{};
+
+    public:
+      consteval FixedString(const char (&text)[Size])
+      {
+        std::copy_n(text, Size, value);
+      }
+
+      [[nodiscard]] constexpr std::string_view view() const noexcept
+      {
+        return std::string_view{value, Size - 1UL};
+      }
+    };
+
+    /**
+     * @brief Column types that can be produced during constant evaluation
+     *
+     * std::string cannot outlive constant evaluation, std::string_view fields
+     * refer to a static unescaped copy of the literal instead.
+     */
+    template<typename T>
+    concept StaticField = ConvertibleField<T> == true && std::is_same_v<T, std::string> == false;
+
+    /*
+     * Not constexpr on purpose: reaching it while parsing during constant
+     * evaluation is what turns malformed data into a compile error, and the
+     * message shows up in the diagnostic.
+     */
+    [[noreturn]] inline void staticFormatError(const char* message)
+    {
+      throw err::FormatError{message};
+    }
+
+    /**
+     * @brief Number of rows in a csv text, a last row without Row symbol included
+     *
+     * @tparam Cfg Configuration class that consists of char enum providing symbols
+     */
+    template<class Cfg>
+    [[nodiscard]] consteval size_t countRows(std::string_view text)
+    {
+      size_t rows{};
+      bool quote{false};
+      bool content{false};
+
+      for (const auto& symbol : text)
+      {
+        if (symbol == Cfg::Symbol::Escape)
+          quote = !quote;
+        else if (symbol == Cfg::Symbol::Row && quote == false)
+        {
+          ++rows;
+          content = false;
+          continue;
+        }
+
+        content = true;
+      }
+
+      return content == true ? rows + 1UL : rows;
+    }
+
+    /**
+     * @brief Copy of a csv literal with every escaped field unescaped in place
+     *
+     * The unescaped text of a field starts right after its opening Escape, the
+     * bytes it no longer needs keep their old values. Offsets of fields are the
+     * same as in the literal, so parseStaticField can take its string_view from
+     * here while it still walks the literal.
+     */
+    template<class Cfg, size_t Size>
+    [[nodiscard]] consteval FixedString<Size> unescapeFields(FixedString<Size> text)
+    {
+      std::string_view source{text.view()};
+
+      for (size_t position{}; position < source.size();)
+      {
+        if (source[position] == Cfg::Symbol::Escape)
+        {
+          size_t write{++position};
+
+          for (; position < source.size(); ++position)
+          {
+            if (source[position] == Cfg::Symbol::Escape)
+            {
+              if (position + 1UL == source.size() || source[position + 1UL] != Cfg::Symbol::Escape)
+                break;
+
+              ++position;
+            }
+
+            text.value[write++] = source[position];
+          }
+
+          ++position;
+        }
+
+        while (position < source.size() && source[position] != Cfg::Symbol::Column && source[position] != Cfg::Symbol::Row)
+          ++position;
+
+        ++position;
+      }
+
+      return text;
+    }
+
+    /* Static storage for the unescaped copy, string_view fields of a parsed table refer to it */
+    template<class Cfg, FixedString Text>
+    inline constexpr auto unescapedText{unescapeFields<Cfg>(Text)};
+
+    /**
+     * @brief Parses one field starting at position and moves past its separator
+     *
+     * A doubled Escape inside an escaped field is one literal Escape, the field
+     * itself is taken from unescaped (see unescapeFields).
+     */
+    template<class Cfg, StaticField T>
+    constexpr void parseStaticField(std::string_view text, std::string_view unescaped, size_t& position, T& value, bool last)
+    {
+      std::string_view field;
+
+      if (position < text.size() && text[position] == Cfg::Symbol::Escape)
+      {
+        size_t start{++position};
+        size_t length{};
+
+        for (;; ++length, ++position)
+        {
+          if (position == text.size())
+            staticFormatError("Unpaired escape character");
+
+          if (text[position] == Cfg::Symbol::Escape)
+          {
+            if (position + 1UL == text.size() || text[position + 1UL] != Cfg::Symbol::Escape)
+              break;
+
+            ++position;
+          }
+        }
+
+        field = unescaped.substr(start, length);
+        ++position;
+      }
+      else
+      {
+        size_t end{position};
+
+        while (end < text.size() && text[end] != Cfg::Symbol::Column && text[end] != Cfg::Symbol::Row)
+          ++end;
+
+        field = text.substr(position, end - position);
+        position = end;
+      }
+
+      if (position < text.size())
+      {
+        if (text[position] != (last == true ? Cfg::Symbol::Row : Cfg::Symbol::Column))
+          staticFormatError("Invalid column size");
+
+        ++position;
+      }
+      else if (last == false)
+        staticFormatError("Invalid column size");
+
+      if (field.empty() == true)
+        staticFormatError("Invalid column size");
+
+      if (FieldTraits<T>::parse(field, value) == false)
+        staticFormatError("Invalid data type");
+    }
+
+    /**
+     * @brief Parses a csv literal during compilation
+     *
+     * @tparam Cfg Configuration class that consists of char enum providing symbols
+     * @tparam Text Csv text without header lines
+     * @tparam Types... Column types (arithmetic, bool, std::string_view or any constexpr FieldTraits)
+     *
+     * The same FieldTraits as the runtime parsers convert the fields, so a
+     * table parsed here holds exactly the values a runtime parse would.
+     * Malformed data fails the compilation with the reason in the diagnostic.
+     *
+     * @return nop::container::array with one tuple per row
+     */
+    template<class Cfg, FixedString Text, StaticField... Types>
+    [[nodiscard]] consteval auto parseStatic()
+    {
+      constexpr std::string_view text{Text.view()};
+      constexpr std::string_view unescaped{unescapedText<Cfg, Text>.view()};
+      nop::container::array<std::tuple<Types...>, countRows<Cfg>(text)> rows{};
+      size_t position{};
+
+      for (auto& row : rows)
+        std::apply([&text, &unescaped, &position](auto&... fields)
+        {
+          size_t column{};
+          (parseStaticField<Cfg>(text, unescaped, position, fields, ++column == sizeof...(Types)), ...);
+        }, row);
+
+      return rows;
+    }
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End static parser header file */
@@ -0,0 +1,85 @@
+#ifndef NOP_CSV_THREAD_POOL_HPP   /* Begin thread pool header file */
+#define NOP_CSV_THREAD_POOL_HPP 1
+
+#include <deque>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <exception>
+#include <condition_variable>
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Work-stealing thread pool
+     *
+     * @class ThreadPool
+     *
+     * Every worker owns a deque of tasks and, once it is empty, steals the
+     * oldest task of another worker's deque. Submissions are spread
+     * round-robin over the deques and taken in submission order, so tasks
+     * submitted largest first keep all workers busy until the very end.
+     */
+    class ThreadPool
+    {
+    public:
+      using Task = std::function<void()>;
+
+    private:
+      struct Queue
+      {
+        std::mutex lock;
+        std::deque<Task> tasks;
+      };
+
+    private:
+      std::vector<std::unique_ptr<Queue>> m_queues;
+      std::vector<std::thread> m_threads;
+      std::mutex m_lock;
+      std::condition_variable m_wake;
+      std::condition_variable m_idle;
+      size_t m_queued;
+      size_t m_pending;
+      size_t m_next;
+      bool m_stop;
+      std::exception_ptr m_error;
+
+    private:
+      [[nodiscard]] bool tryPop(size_t, Task&);
+      void run(size_t);
+
+    public:
+      explicit ThreadPool(size_t);
+      ThreadPool(const ThreadPool&) = delete;
+      ThreadPool(ThreadPool&&) = delete;
+      ~ThreadPool();
+
+      /**
+       * @brief Queues a task, may be called from any thread including workers
+       */
+      void submit(Task);
+
+      /**
+       * @brief Blocks until every submitted task has finished
+       *
+       * @throws the first exception thrown by a task
+       */
+      void wait();
+
+      [[nodiscard]] size_t size() const noexcept;
+
+      ThreadPool& operator=(const ThreadPool&) = delete;
+      ThreadPool& operator=(ThreadPool&&) = delete;
+    };
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End thread pool header file */
@@ -0,0 +1,261 @@
+#ifndef NOP_CSV_TOKENIZER_HPP   /* Begin tokenizer header file */
+#define NOP_CSV_TOKENIZER_HPP 1
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <istream>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <fmt/format.h>
+#include "exception.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Splits rows of csv text held in memory into unescaped fields
+     *
+     * @class RowSplitter
+     *
+     * @tparam Cfg Configuration class that consists of char enum providing symbols
+     *
+     * The number of columns is a runtime value. Plain fields refer to the
+     * text itself, escaped ones to per-column scratch strings, so a row stays
+     * valid until the next call of split().
+     */
+    template<class Cfg>
+    class RowSplitter
+    {
+    private:
+      std::vector<std::string_view> m_fields;
+      std::vector<std::string> m_unescaped;
+
+    private:
+      [[noreturn]] static void formatError(const char* message, uint64_t row, size_t column)
+      {
+        throw err::FormatError{fmt::format(
+              "\033[1;35m[ERROR]\033[0m {}\n"
+              "\033[1;35m[MESSAGE]\033[0m Parse error position : <Row:{};Column:{}>"
+              , message
+              , row
+              , column + 1UL)};
+      }
+
+    public:
+      explicit RowSplitter(size_t columns)
+        : m_fields(columns)
+        , m_unescaped(columns)
+      {}
+
+      /**
+       * @brief Number of fields in the first row of text
+       *
+       * @param [in] text Csv text, a row cut off by its end counts as complete
+       */
+      [[nodiscard]] static size_t countColumns(std::string_view text) noexcept
+      {
+        size_t columns{1UL};
+        bool quoted{false};
+
+        for (const auto& symbol : text)
+        {
+          if (symbol == Cfg::Symbol::Escape)
+            quoted = quoted == false;
+          else if (quoted == false && symbol == Cfg::Symbol::Column)
+            ++columns;
+          else if (quoted == false && symbol == Cfg::Symbol::Row)
+            break;
+        }
+
+        return columns;
+      }
+
+      /**
+       * @brief Splits the row starting at position
+       *
+       * @param [in] text Csv text
+       * @param [in] position Offset of the first symbol of the row
+       * @param [in] last Whether text ends the input (a final row needs no Row symbol)
+       * @param [in] row Row number used in error messages
+       *
+       * @return Offset after the Row symbol, npos if text cuts the row off
+       *
+       * @throws format_error
+       */
+      [[nodiscard]] size_t split(std::string_view text, size_t position, bool last, uint64_t row)
+      {
+        const size_t columns{m_fields.size()};
+
+        for (size_t column{}; column < columns; ++column)
+        {
+          if (position < text.size() && text[position] == Cfg::Symbol::Escape)
+          {
+            std::string& unescaped{m_unescaped[column]};
+            unescaped.clear();
+
+            for (++position;;)
+            {
+              size_t end{text.find(Cfg::Symbol::Escape, position)};
+
+              /* A closing Escape at the end of text may still be the first half of a doubled one */
+              if (end == std::string_view::npos || end + 1UL == text.size())
+              {
+                if (last == false)
+                  return std::string_view::npos;
+
+                if (end == std::string_view::npos)
+                  formatError("Unpaired escape character.", row, column);
+              }
+
+              unescaped.append(text.substr(position, end - position));
+              position = end + 1UL;
+
+              if (position < text.size() && text[position] == Cfg::Symbol::Escape)
+              {
+                unescaped.push_back(Cfg::Symbol::Escape);
+                ++position;
+              }
+              else
+                break;
+            }
+
+            m_fields[column] = unescaped;
+          }
+          else
+          {
+            size_t end{position};
+
+            while (end < text.size() && text[end] != Cfg::Symbol::Column && text[end] != Cfg::Symbol::Row)
+              ++end;
+
+            m_fields[column] = text.substr(position, end - position);
+            position = end;
+          }
+
+          if (position == text.size())
+          {
+            if (last == false)
+              return std::string_view::npos;
+
+            if (column + 1UL < columns)
+              formatError("Invalid column size.", row, column);
+          }
+          else if (text[position] != (column + 1UL < columns ? Cfg::Symbol::Column : Cfg::Symbol::Row))
+            formatError("Invalid column size.", row, column);
+          else
+            ++position;
+        }
+
+        return position;
+      }
+
+      [[nodiscard]] const std::vector<std::string_view>& fields() const noexcept
+      {
+        return m_fields;
+      }
+    };
+
+    /**
+     * @brief Reads a stream in blocks that keep the unconsumed tail of the previous one
+     *
+     * @class BlockReader
+     *
+     * @tparam Cfg Configuration class that consists of char enum providing symbols
+     *
+     * The consumer passes the number of bytes it used from the last block to
+     * read(), the rest (a row cut off by the block end) is moved to the front
+     * of the next block. A row longer than the block grows the block.
+     */
+    template<class Cfg>
+    class BlockReader
+    {
+    private:
+      std::istream* m_in;
+      std::string m_block;
+      size_t m_size;
+      uint64_t m_limit;
+      size_t m_blockSize;
+      bool m_last;
+
+    public:
+      /**
+       * @brief BlockReader constructor
+       *
+       * @param [in] in Input stream
+       * @param [in] skipLines Lines skipped first
+       * @param [in] limit Number of bytes to read at most
+       * @param [in] blockSize Bytes read per block
+       *
+       * @throws invalid_argument
+       */
+      BlockReader(std::istream& in, size_t skipLines, uint64_t limit, size_t blockSize)
+        : m_in{&in}
+        , m_block{}
+        , m_size{0UL}
+        , m_limit{limit}
+        , m_blockSize{blockSize}
+        , m_last{false}
+      {
+        if (in.good() == false)
+          throw err::InvalidArgument{"\033[1;35m[ERROR]\033[0m Invalid file stream.\n"
+                                     "\033[1;35m[MESSAGE]\033[0m Cannot parse the file."};
+
+        while (skipLines > 0UL && m_limit > 0UL && in.eof() == false)
+        {
+          --m_limit;
+
+          if (in.get() == Cfg::Symbol::Row)
+            --skipLines;
+        }
+      }
+
+      /**
+       * @brief Drops consumed bytes of the current block and reads the next one
+       *
+       * @param [in] consumed Bytes of text() used by the consumer
+       *
+       * @return false once the last block was handed out
+       */
+      [[nodiscard]] bool read(size_t consumed)
+      {
+        if (m_last == true)
+          return false;
+
+        size_t pending{m_size - consumed};
+        std::memmove(m_block.data(), m_block.data() + consumed, pending);
+        m_block.resize(std::max(pending * 2UL, pending + m_blockSize));
+
+        size_t wanted{static_cast<size_t>(std::min<uint64_t>(m_block.size() - pending, m_limit))};
+        m_in->read(m_block.data() + pending, static_cast<std::streamsize>(wanted));
+        size_t read{static_cast<size_t>(m_in->gcount())};
+
+        m_limit -= read;
+        m_last = read < wanted || m_limit == 0UL;
+        m_size = pending + read;
+        return true;
+      }
+
+      [[nodiscard]] std::string_view text() const noexcept
+      {
+        return std::string_view{m_block.data(), m_size};
+      }
+
+      /**
+       * @brief Whether text() ends the input
+       */
+      [[nodiscard]] bool last() const noexcept
+      {
+        return m_last;
+      }
+    };
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End tokenizer header file */
@@ -0,0 +1,37 @@
+#ifndef NOP_CSV_UTF8_HPP   /* Begin utf8 header file */
+#define NOP_CSV_UTF8_HPP 1
+
+#include <string_view>
+#include <cstddef>
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Configurations declaring `static constexpr bool ValidateUtf8{true}`
+     *        make the parsers reject string fields that are not valid UTF-8
+     */
+    template<class Cfg>
+    concept ValidatesUtf8 = requires { requires Cfg::ValidateUtf8 == true; };
+
+    /**
+     * @brief Finds the first invalid UTF-8 sequence
+     *
+     * Validates 32 bytes per step with the lookup-table algorithm of Keiser and
+     * Lemire (three nibble lookups classify every pair of adjacent bytes) when
+     * the CPU supports AVX2, and falls back to a scalar decoder with an ASCII
+     * fast path otherwise. Overlong forms, surrogates and code points above
+     * U+10FFFF are invalid.
+     *
+     * @return Byte offset of the first invalid sequence, std::string_view::npos if the text is valid
+     */
+    [[nodiscard]] size_t validateUtf8(std::string_view) noexcept;
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End utf8 header file */
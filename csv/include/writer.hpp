@@ -0,0 +1,351 @@
+#ifndef NOP_CSV_WRITER_HPP   /* Begin writer header file */
+#define NOP_CSV_WRITER_HPP 1
+
+#include <tuple>
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <variant>
+#include <memory>
+#include <mutex>
+#include <charconv>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <fmt/format.h>
+#include "exception.hpp"
+#include "convert.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /**
+     * @brief Buffered csv/tsv writer
+     *
+     * @class Writer
+     *
+     * @tparam Cfg Configuration class that consists of char enum providing symbols
+     * @tparam Types... Variadic number of types
+     *
+     * Rows are formatted with std::to_chars straight into one reusable buffer
+     * that is flushed with large write(2) calls. Text fields are wrapped in
+     * Escape symbols only when they contain a special symbol; embedded Escape
+     * symbols are doubled. Column types other than arithmetic and string-like
+     * ones are formatted through FieldTraits<T>::format(char*, char*, const T&).
+     * Writers sharing a descriptor through a common mutex only hand whole rows
+     * to write(2), so their output interleaves row by row. Rows of runtime
+     * typed values (std::variant, std::monostate is an empty field) can be
+     * written by any writer.
+     */
+    template<class Cfg, typename... Types>
+    class Writer
+    {
+    public:
+      static constexpr size_t BufferSize{1UL << 20};
+
+    private:
+      /* Upper bound of a formatted arithmetic value (long double in scientific notation) */
+      static constexpr size_t NumberSize{64UL};
+
+      static constexpr std::array<bool, 256UL> special{[]
+      {
+        std::array<bool, 256UL> table{};
+        table[static_cast<unsigned char>(Cfg::Symbol::Column)] = true;
+        table[static_cast<unsigned char>(Cfg::Symbol::Row)] = true;
+        table[static_cast<unsigned char>(Cfg::Symbol::Escape)] = true;
+        return table;
+      }()};
+
+    private:
+      int32_t m_file;
+      bool m_owner;
+      std::mutex* m_lock;
+      std::unique_ptr<char[]> m_buffer;
+      size_t m_size;
+      size_t m_rowEnd;
+
+    private:
+      void writeAll(const char* data, size_t size)
+      {
+        std::unique_lock<std::mutex> guard;
+
+        if (m_lock != nullptr)
+          guard = std::unique_lock<std::mutex>{*m_lock};
+
+        while (size > 0UL)
+        {
+          ssize_t written{::write(m_file, data, size)};
+
+          if (written < 0 && errno == EINTR)
+            continue;
+
+          if (written < 0)
+            throw err::SystemError{fmt::format(
+                  "\033[1;35m[ERROR]\033[0m Cannot write csv output.\n"
+                  "\033[1;35m[MESSAGE]\033[0m {}"
+                  , std::strerror(errno))};
+
+          data += written;
+          size -= static_cast<size_t>(written);
+        }
+      }
+
+      [[nodiscard]] char* reserve(size_t size)
+      {
+        if (m_size + size <= BufferSize)
+          return m_buffer.get() + m_size;
+
+        /* Keep the unfinished row buffered unless it alone overflows the buffer */
+        if (m_rowEnd != 0UL && m_size - m_rowEnd + size <= BufferSize)
+        {
+          writeAll(m_buffer.get(), m_rowEnd);
+          std::memmove(m_buffer.get(), m_buffer.get() + m_rowEnd, m_size - m_rowEnd);
+          m_size -= m_rowEnd;
+          m_rowEnd = 0UL;
+        }
+        else
+          flush();
+
+        return m_buffer.get() + m_size;
+      }
+
+      void writeText(std::string_view text)
+      {
+        bool quote{false};
+
+        for (const auto& symbol : text)
+          if (special[static_cast<unsigned char>(symbol)] == true)
+          {
+            quote = true;
+            break;
+          }
+
+        /* Worst case: every symbol is an Escape that has to be doubled */
+        size_t bound{quote == true ? text.size() * 2UL + 2UL : text.size()};
+
+        if (bound > BufferSize)
+        {
+          flush();
+          std::string large;
+          large.reserve(bound);
+
+          if (quote == true)
+            large.push_back(Cfg::Symbol::Escape);
+
+          for (const auto& symbol : text)
+          {
+            if (quote == true && symbol == Cfg::Symbol::Escape)
+              large.push_back(symbol);
+            large.push_back(symbol);
+          }
+
+          if (quote == true)
+            large.push_back(Cfg::Symbol::Escape);
+
+          writeAll(large.data(), large.size());
+          return;
+        }
+
+        char* out{reserve(bound)};
+
+        if (quote == false)
+        {
+          std::memcpy(out, text.data(), text.size());
+          m_size += text.size();
+          return;
+        }
+
+        char* begin{out};
+        *out++ = Cfg::Symbol::Escape;
+
+        for (const auto& symbol : text)
+        {
+          if (symbol == Cfg::Symbol::Escape)
+            *out++ = symbol;
+          *out++ = symbol;
+        }
+
+        *out++ = Cfg::Symbol::Escape;
+        m_size += static_cast<size_t>(out - begin);
+      }
+
+      template<typename T>
+      void writeField(const T& value)
+      {
+        if constexpr (std::is_same_v<T, std::monostate> == true)
+          return;
+        else if constexpr (std::is_same_v<T, bool> == true)
+        {
+          *reserve(1UL) = value == true ? '1' : '0';
+          ++m_size;
+        }
+        else if constexpr (std::is_arithmetic_v<T> == true)
+        {
+          char* out{reserve(NumberSize)};
+          auto [end, code]{std::to_chars(out, out + NumberSize, value)};
+          m_size += static_cast<size_t>(end - out);
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::string_view> == true)
+          writeText(std::string_view{value});
+        else
+        {
+          char* out{reserve(NumberSize)};
+          m_size += static_cast<size_t>(FieldTraits<T>::format(out, out + NumberSize, value) - out);
+        }
+      }
+
+      template<size_t... Indices>
+      void writeFields(const std::tuple<Types...>& row, std::index_sequence<Indices...>)
+      {
+        ((Indices == 0UL ? static_cast<void>(0) : writeSymbol(Cfg::Symbol::Column),
+          writeField(std::get<Indices>(row))), ...);
+      }
+
+      void writeSymbol(char symbol)
+      {
+        *reserve(1UL) = symbol;
+        ++m_size;
+      }
+
+    public:
+      /**
+       * @brief Writer over an already open file descriptor (not closed by the writer)
+       *
+       * @param [in] file Output file descriptor, e.g. STDOUT_FILENO
+       */
+      explicit Writer(int32_t file)
+        : m_file{file}
+        , m_owner{false}
+        , m_lock{nullptr}
+        , m_buffer{std::make_unique<char[]>(BufferSize)}
+        , m_size{0UL}
+        , m_rowEnd{0UL}
+      {}
+
+      /**
+       * @brief Writer over a file descriptor shared with other writers
+       *
+       * @param [in] file Output file descriptor (not closed by the writer)
+       * @param [in] lock Mutex held by every writer of this descriptor while writing
+       */
+      Writer(int32_t file, std::mutex& lock)
+        : m_file{file}
+        , m_owner{false}
+        , m_lock{&lock}
+        , m_buffer{std::make_unique<char[]>(BufferSize)}
+        , m_size{0UL}
+        , m_rowEnd{0UL}
+      {}
+
+      /**
+       * @brief Writer creating (or truncating) a file
+       *
+       * @param [in] fileName Output file path
+       *
+       * @throws invalid_argument
+       */
+      explicit Writer(const char* fileName)
+        : m_file{::open(fileName, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)}
+        , m_owner{true}
+        , m_lock{nullptr}
+        , m_buffer{std::make_unique<char[]>(BufferSize)}
+        , m_size{0UL}
+        , m_rowEnd{0UL}
+      {
+        if (m_file < 0)
+          throw err::InvalidArgument{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Cannot open output file.\n"
+                "\033[1;35m[MESSAGE]\033[0m Path : {}"
+                , fileName)};
+      }
+
+      Writer(const Writer&) = delete;
+      Writer(Writer&&) = delete;
+
+      ~Writer()
+      {
+        try
+        {
+          flush();
+        }
+        catch (const err::BaseException&)
+        {}
+
+        if (m_owner == true)
+          ::close(m_file);
+      }
+
+      /**
+       * @brief Appends one row to the buffer
+       *
+       * @throws system_error if a flush fails
+       */
+      void write(const std::tuple<Types...>& row)
+      {
+        writeFields(row, std::index_sequence_for<Types...>{});
+        writeSymbol(Cfg::Symbol::Row);
+        m_rowEnd = m_size;
+      }
+
+      /**
+       * @brief Hands the buffered bytes to the kernel
+       *
+       * @throws system_error
+       */
+      void flush()
+      {
+        size_t size{m_size};
+        m_size = 0UL;
+        m_rowEnd = 0UL;
+        writeAll(m_buffer.get(), size);
+      }
+
+      /**
+       * @brief Appends one row of runtime typed values to the buffer
+       *
+       * @throws system_error if a flush fails
+       */
+      template<typename... Alternatives>
+      void write(const std::vector<std::variant<Alternatives...>>& row)
+      {
+        for (size_t i{}; i < row.size(); ++i)
+        {
+          if (i != 0UL)
+            writeSymbol(Cfg::Symbol::Column);
+
+          std::visit([this](const auto& value) { writeField(value); }, row[i]);
+        }
+
+        writeSymbol(Cfg::Symbol::Row);
+        m_rowEnd = m_size;
+      }
+
+      Writer& operator<<(const std::tuple<Types...>& row)
+      {
+        write(row);
+        return *this;
+      }
+
+      template<typename... Alternatives>
+      Writer& operator<<(const std::vector<std::variant<Alternatives...>>& row)
+      {
+        write(row);
+        return *this;
+      }
+
+      Writer& operator=(const Writer&) = delete;
+      Writer& operator=(Writer&&) = delete;
+    };
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
+
+#endif /* End writer header file */
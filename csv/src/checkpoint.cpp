@@ -0,0 +1,78 @@
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <fstream>
+#include <fmt/format.h>
+#include "checkpoint.hpp"
+#include "exception.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    static constexpr char checkpointMagic[8]{'N', 'O', 'P', 'C', 'K', 'P', 'T', '1'};
+
+    Checkpoint Checkpoint::load(const char* fileName)
+    {
+      std::ifstream in{fileName, std::ios_base::in | std::ios_base::binary};
+
+      if (in.is_open() == false)
+        throw err::InvalidArgument{fmt::format(
+              "\033[1;35m[ERROR]\033[0m Cannot open checkpoint file.\n"
+              "\033[1;35m[MESSAGE]\033[0m Path : {}"
+              , fileName)};
+
+      char magic[sizeof(checkpointMagic)]{};
+      Checkpoint checkpoint{};
+      char inQuote{};
+
+      in.read(magic, sizeof(magic));
+      in.read(reinterpret_cast<char*>(&checkpoint.offset), sizeof(checkpoint.offset));
+      in.read(reinterpret_cast<char*>(&checkpoint.row), sizeof(checkpoint.row));
+      in.read(&inQuote, sizeof(inQuote));
+
+      if (in.fail() == true || std::memcmp(magic, checkpointMagic, sizeof(magic)) != 0)
+        throw err::FormatError{fmt::format(
+              "\033[1;35m[ERROR]\033[0m Invalid checkpoint file.\n"
+              "\033[1;35m[MESSAGE]\033[0m Path : {}"
+              , fileName)};
+
+      checkpoint.inQuote = inQuote != 0;
+      return checkpoint;
+    }
+
+    void Checkpoint::save(const char* fileName) const
+    {
+      std::string temporary{fmt::format("{}.tmp", fileName)};
+
+      {
+        std::ofstream out{temporary, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc};
+        char quote{static_cast<char>(inQuote)};
+
+        out.write(checkpointMagic, sizeof(checkpointMagic));
+        out.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+        out.write(reinterpret_cast<const char*>(&row), sizeof(row));
+        out.write(&quote, sizeof(quote));
+        out.close();
+
+        if (out.fail() == true)
+          throw err::SystemError{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Cannot write checkpoint file.\n"
+                "\033[1;35m[MESSAGE]\033[0m Path : {}"
+                , temporary)};
+      }
+
+      /* rename() replaces the previous checkpoint atomically */
+      if (std::rename(temporary.c_str(), fileName) != 0)
+        throw err::SystemError{fmt::format(
+              "\033[1;35m[ERROR]\033[0m Cannot replace checkpoint file.\n"
+              "\033[1;35m[MESSAGE]\033[0m {}"
+              , std::strerror(errno))};
+    }
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <filesystem>
 #include "command.hpp"
 #include "exception.hpp"
 
@@ -7,36 +9,161 @@ namespace csv /* Begin namespace csv */
   namespace cmd /* Begin namespace cmd */
   {
 
+    [[nodiscard]] static bool parseNumber(std::string_view digit, size_t& value) noexcept
+    {
+      if (digit.empty() == true)
+        return false;
+
+      /* value is left as is on failure, a file name like 1.csv must not change it */
+      size_t number{};
+
+      for (const auto& symbol : digit)
+      {
+        if (symbol > '9' || symbol < '0')
+          return false;
+
+        number = number * 10UL + static_cast<size_t>(symbol - '0');
+      }
+
+      value = number;
+      return true;
+    }
+
+    [[nodiscard]] static bool isCsvFile(std::string_view fileName) noexcept
+    {
+      return fileName.ends_with(".csv") == true ||
+             fileName.ends_with(".csv.gz") == true ||
+             fileName.ends_with(".csv.zst") == true;
+    }
+
     DataHandler::DataHandler(int32_t argc, char* argv[])
+      : m_files{}
+      , m_skipLines{0UL}
+      , m_directory{false}
+      , m_threads{0UL}
+      , m_chunkSize{0UL} /* Opt-in, chunk boundaries do not track quoting (see splitFiles) */
+      , m_follow{false}
+      , m_checkpoint{}
+      , m_checkpointInterval{1000000UL}
+      , m_sortColumn{0UL}
+      , m_memory{1024UL}
+      , m_tempDir{}
+      , m_joinFile{}
+      , m_joinColumn{1UL}
+      , m_profile{false}
+      , m_infer{false}
+      , m_sample{64UL}
     {
-      if (2 <= argc && argc <= 3)
+      bool skipLines{false};
+
+      for (int32_t i{1}; i < argc; ++i)
       {
-        m_data.first = argv[1];
-        
-        if (m_data.first.ends_with(".csv") == false)
-          goto ERROR;
+        std::string_view argument{argv[i]};
+
+        if (argument.starts_with("--threads=") == true)
+        {
+          if (parseNumber(argument.substr(10UL), m_threads) == false)
+            goto ERROR;
+        }
+        else if (argument.starts_with("--checkpoint=") == true)
+        {
+          m_checkpoint = argument.substr(13UL);
+
+          if (m_checkpoint.empty() == true)
+            goto ERROR;
+        }
+        else if (argument.starts_with("--checkpoint-interval=") == true)
+        {
+          if (parseNumber(argument.substr(22UL), m_checkpointInterval) == false || m_checkpointInterval == 0UL)
+            goto ERROR;
+        }
+        else if (argument.starts_with("--sort=") == true)
+        {
+          if (parseNumber(argument.substr(7UL), m_sortColumn) == false || m_sortColumn == 0UL)
+            goto ERROR;
+        }
+        else if (argument.starts_with("--memory=") == true)
+        {
+          if (parseNumber(argument.substr(9UL), m_memory) == false || m_memory == 0UL)
+            goto ERROR;
+        }
+        else if (argument.starts_with("--temp-dir=") == true)
+        {
+          m_tempDir = argument.substr(11UL);
 
-        if (argc == 3)
+          if (m_tempDir.empty() == true)
+            goto ERROR;
+        }
+        else if (argument.starts_with("--join=") == true)
+        {
+          m_joinFile = argument.substr(7UL);
+
+          if (isCsvFile(m_joinFile) == false)
+            goto ERROR;
+        }
+        else if (argument.starts_with("--on=") == true)
+        {
+          if (parseNumber(argument.substr(5UL), m_joinColumn) == false || m_joinColumn == 0UL)
+            goto ERROR;
+        }
+        else if (argument.starts_with("--chunk-size=") == true)
         {
-          std::string digit{argv[2]};
+          if (parseNumber(argument.substr(13UL), m_chunkSize) == false)
+            goto ERROR;
+        }
+        else if (argument == "--follow")
+          m_follow = true;
+        else if (argument == "--profile")
+          m_profile = true;
+        else if (argument == "--infer")
+          m_infer = true;
+        else if (argument.starts_with("--sample=") == true)
+        {
+          if (parseNumber(argument.substr(9UL), m_sample) == false || m_sample == 0UL)
+            goto ERROR;
+        }
+        else if (skipLines == false && m_files.empty() == false && parseNumber(argument, m_skipLines) == true)
+          skipLines = true;
+        else if (skipLines == false && std::filesystem::is_directory(argument) == true)
+        {
+          size_t first{m_files.size()};
+          m_directory = true;
 
-          for (const auto& symbol : digit)
-            if (symbol > '9' || symbol < '0')
-              goto ERROR;
+          for (const auto& entry : std::filesystem::directory_iterator{argument})
+            if (entry.is_regular_file() == true && isCsvFile(entry.path().native()) == true)
+              m_files.push_back(entry.path().string());
 
-          m_data.second = std::strtoull(digit.c_str(), NULL, 10UL);
+          /* Directory order is unspecified, keep runs reproducible */
+          std::sort(m_files.begin() + static_cast<std::ptrdiff_t>(first), m_files.end());
         }
+        else if (skipLines == false && (argument == "-" || isCsvFile(argument) == true))
+          m_files.emplace_back(argument);
         else
-          m_data.second = 0;
+          goto ERROR;
       }
-      else
+
+      /* Only a single plain file on disk can grow under us or be seeked into */
+      if (m_files.empty() == true ||
+          (isMultiFile() == true && (std::ranges::count(m_files, "-") > 0 || m_follow == true || m_checkpoint.empty() == false)) ||
+          ((m_sortColumn != 0UL || m_joinFile.empty() == false) &&
+           (isMultiFile() == true || m_follow == true || m_checkpoint.empty() == false)) ||
+          (m_sortColumn != 0UL && m_joinFile.empty() == false) ||
+          ((m_profile == true || m_infer == true) &&
+           (m_sortColumn != 0UL || m_joinFile.empty() == false || m_follow == true || m_checkpoint.empty() == false)) ||
+          (m_infer == true && (m_profile == true || isMultiFile() == true)) ||
+          ((m_follow == true || m_checkpoint.empty() == false) && m_files.front().ends_with(".csv") == false))
       {
 ERROR:
         using namespace std::string_literals;
 
         std::string errorMessage{
             "\033[1;35m[ERROR]\033[0m Invalid parameters.\n"
-            "\033[1;35m[MESSAGE]\033[0m Requires <file.csv> <skip_lines> (optional)\n"
+            "\033[1;35m[MESSAGE]\033[0m Requires <file.csv[.gz|.zst]|directory|->... <skip_lines> (optional)\n"
+            "\033[1;35m[MESSAGE]\033[0m Options: --threads=<conversion_workers> --chunk-size=<MiB> --follow\n"
+            "\033[1;35m[MESSAGE]\033[0m          --checkpoint=<file> --checkpoint-interval=<rows>\n"
+            "\033[1;35m[MESSAGE]\033[0m          --sort=<column> --memory=<MiB> --temp-dir=<dir>\n"
+            "\033[1;35m[MESSAGE]\033[0m          --join=<file.csv[.gz|.zst]> --on=<column> --profile\n"
+            "\033[1;35m[MESSAGE]\033[0m          --infer --sample=<KiB>\n"
             "\033[1;35m[MESSAGE]\033[0m Recieved: "};
 
         if (argc > 1)
@@ -53,12 +180,92 @@ ERROR:
 
     const char* DataHandler::getFileName() const noexcept
     {
-      return m_data.first.data();
+      return m_files.front().c_str();
+    }
+
+    const std::vector<std::string>& DataHandler::getFiles() const noexcept
+    {
+      return m_files;
+    }
+
+    bool DataHandler::isMultiFile() const noexcept
+    {
+      return m_directory == true || m_files.size() > 1UL;
+    }
+
+    size_t DataHandler::getChunkSize() const noexcept
+    {
+      return m_chunkSize;
     }
 
     size_t DataHandler::getSkipLines() const noexcept
     {
-      return m_data.second;
+      return m_skipLines;
+    }
+
+    bool DataHandler::isStdin() const noexcept
+    {
+      return m_files.front() == "-";
+    }
+
+    size_t DataHandler::getThreads() const noexcept
+    {
+      return m_threads;
+    }
+
+    bool DataHandler::isFollow() const noexcept
+    {
+      return m_follow;
+    }
+
+    const char* DataHandler::getCheckpoint() const noexcept
+    {
+      return m_checkpoint.empty() == true ? nullptr : m_checkpoint.data();
+    }
+
+    size_t DataHandler::getCheckpointInterval() const noexcept
+    {
+      return m_checkpointInterval;
+    }
+
+    size_t DataHandler::getSortColumn() const noexcept
+    {
+      return m_sortColumn;
+    }
+
+    size_t DataHandler::getMemory() const noexcept
+    {
+      return m_memory;
+    }
+
+    const char* DataHandler::getTempDir() const noexcept
+    {
+      return m_tempDir.empty() == true ? nullptr : m_tempDir.data();
+    }
+
+    const char* DataHandler::getJoinFile() const noexcept
+    {
+      return m_joinFile.empty() == true ? nullptr : m_joinFile.data();
+    }
+
+    size_t DataHandler::getJoinColumn() const noexcept
+    {
+      return m_joinColumn;
+    }
+
+    bool DataHandler::isProfile() const noexcept
+    {
+      return m_profile;
+    }
+
+    bool DataHandler::isInfer() const noexcept
+    {
+      return m_infer;
+    }
+
+    size_t DataHandler::getSample() const noexcept
+    {
+      return m_sample;
     }
 
   } /* End namespace cmd */
@@ -0,0 +1,36 @@
+#include "datetime.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    char* formatDate(char* out, std::chrono::sys_days days) noexcept
+    {
+      std::chrono::year_month_day date{days};
+      auto year{static_cast<int32_t>(date.year())};
+      auto month{static_cast<uint32_t>(date.month())};
+      auto day{static_cast<uint32_t>(date.day())};
+
+      if (year < 0)
+      {
+        *out++ = '-';
+        year = -year;
+      }
+
+      for (int32_t i{4}; i-- > 0; year /= 10)
+        out[i] = static_cast<char>('0' + year % 10);
+
+      out[4] = '-';
+      out[5] = static_cast<char>('0' + month / 10U);
+      out[6] = static_cast<char>('0' + month % 10U);
+      out[7] = '-';
+      out[8] = static_cast<char>('0' + day / 10U);
+      out[9] = static_cast<char>('0' + day % 10U);
+      return out + DateTimeDigits::DateSize;
+    }
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
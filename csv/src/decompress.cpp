@@ -0,0 +1,270 @@
+#include <fmt/format.h>
+#include "decompress.hpp"
+#include "exception.hpp"
+
+#ifdef NOP_CSV_HAS_ZLIB
+  #include <zlib.h>
+#endif
+
+#ifdef NOP_CSV_HAS_ZSTD
+  #include <zstd.h>
+#endif
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    Codec detectCodec(std::string_view fileName) noexcept
+    {
+      if (fileName.ends_with(".gz") == true)
+        return Codec::Gzip;
+      else if (fileName.ends_with(".zst") == true)
+        return Codec::Zstd;
+      else
+        return Codec::None;
+    }
+
+    DecompressBuf::DecompressBuf(const char* fileName, Codec codec)
+      : m_file{fileName, std::ios_base::in | std::ios_base::binary}
+      , m_codec{codec}
+    {
+      if (m_file.is_open() == false)
+        return;
+
+      for (size_t i{}; i < RingBlocks; ++i)
+      {
+        auto block{std::make_unique<Block>(std::make_unique<char[]>(BlockSize), 0UL)};
+
+        if (m_free.tryPush(block) == false)
+          break;
+      }
+
+      m_worker = std::thread{&DecompressBuf::run, this};
+    }
+
+    DecompressBuf::~DecompressBuf()
+    {
+      m_filled.close();
+      m_free.close();
+
+      if (m_worker.joinable() == true)
+        m_worker.join();
+    }
+
+    bool DecompressBuf::isOpen() const noexcept
+    {
+      return m_file.is_open();
+    }
+
+    bool DecompressBuf::acquireBlock(std::unique_ptr<Block>& block)
+    {
+      if (block != nullptr)
+        return true;
+
+      if (m_free.pop(block) == false)
+        return false;
+
+      block->size = 0UL;
+      return true;
+    }
+
+    bool DecompressBuf::releaseBlock(std::unique_ptr<Block>& block)
+    {
+      if (block == nullptr || block->size == 0UL)
+        return true;
+
+      return m_filled.push(std::move(block));
+    }
+
+    void DecompressBuf::run() noexcept
+    {
+      try
+      {
+        if (m_codec == Codec::Gzip)
+          inflateGzip();
+        else
+          inflateZstd();
+      }
+      catch (...)
+      {
+        m_error = std::current_exception();
+      }
+
+      m_filled.close();
+    }
+
+    void DecompressBuf::inflateGzip()
+    {
+#ifdef NOP_CSV_HAS_ZLIB
+      z_stream stream{};
+
+      /* 15 window bits + 32 enables automatic gzip/zlib header detection */
+      if (inflateInit2(&stream, 15 + 32) != Z_OK)
+        throw err::RuntimeError{"\033[1;35m[ERROR]\033[0m Cannot initialize gzip decoder."};
+
+      std::unique_ptr<z_stream, decltype(&inflateEnd)> guard{&stream, &inflateEnd};
+      auto input{std::make_unique<char[]>(InputSize)};
+      std::unique_ptr<Block> block;
+      bool memberEnded{false};
+
+      for (;;)
+      {
+        if (stream.avail_in == 0U)
+        {
+          m_file.read(input.get(), InputSize);
+          stream.next_in = reinterpret_cast<Bytef*>(input.get());
+          stream.avail_in = static_cast<uInt>(m_file.gcount());
+
+          if (stream.avail_in == 0U)
+            break;
+        }
+
+        if (acquireBlock(block) == false)
+          return;
+
+        stream.next_out = reinterpret_cast<Bytef*>(block->data.get() + block->size);
+        stream.avail_out = static_cast<uInt>(BlockSize - block->size);
+
+        int32_t status{inflate(&stream, Z_NO_FLUSH)};
+        block->size = BlockSize - stream.avail_out;
+
+        if (status == Z_STREAM_END)
+        {
+          /* Concatenated gzip members are decoded as one stream */
+          memberEnded = true;
+          inflateReset(&stream);
+        }
+        else if (status == Z_OK || status == Z_BUF_ERROR)
+          memberEnded = false;
+        else
+          throw err::FormatError{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Corrupted gzip stream.\n"
+                "\033[1;35m[MESSAGE]\033[0m zlib : {}"
+                , stream.msg != nullptr ? stream.msg : "unknown error")};
+
+        if (block->size == BlockSize && releaseBlock(block) == false)
+          return;
+      }
+
+      if (memberEnded == false && stream.total_in != 0UL)
+        throw err::FormatError{"\033[1;35m[ERROR]\033[0m Truncated gzip stream."};
+
+      static_cast<void>(releaseBlock(block));
+#else
+      throw err::InvalidArgument{"\033[1;35m[ERROR]\033[0m gzip support is not compiled in."};
+#endif
+    }
+
+    void DecompressBuf::inflateZstd()
+    {
+#ifdef NOP_CSV_HAS_ZSTD
+      std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+
+      if (context == nullptr)
+        throw err::RuntimeError{"\033[1;35m[ERROR]\033[0m Cannot initialize zstd decoder."};
+
+      auto input{std::make_unique<char[]>(InputSize)};
+      ZSTD_inBuffer in{input.get(), 0UL, 0UL};
+      std::unique_ptr<Block> block;
+      size_t hint{0UL};
+
+      for (;;)
+      {
+        if (in.pos == in.size)
+        {
+          m_file.read(input.get(), InputSize);
+          in.size = static_cast<size_t>(m_file.gcount());
+          in.pos = 0UL;
+
+          if (in.size == 0UL)
+            break;
+        }
+
+        if (acquireBlock(block) == false)
+          return;
+
+        ZSTD_outBuffer out{block->data.get(), BlockSize, block->size};
+        hint = ZSTD_decompressStream(context.get(), &out, &in);
+        block->size = out.pos;
+
+        if (ZSTD_isError(hint) != 0U)
+          throw err::FormatError{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Corrupted zstd stream.\n"
+                "\033[1;35m[MESSAGE]\033[0m zstd : {}"
+                , ZSTD_getErrorName(hint))};
+
+        if (block->size == BlockSize && releaseBlock(block) == false)
+          return;
+      }
+
+      /* A non-zero hint means the last frame is incomplete */
+      if (hint != 0UL)
+        throw err::FormatError{"\033[1;35m[ERROR]\033[0m Truncated zstd stream."};
+
+      static_cast<void>(releaseBlock(block));
+#else
+      throw err::InvalidArgument{"\033[1;35m[ERROR]\033[0m zstd support is not compiled in."};
+#endif
+    }
+
+    DecompressBuf::int_type DecompressBuf::underflow()
+    {
+      if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+      if (m_current != nullptr)
+        static_cast<void>(m_free.push(std::move(m_current)));
+
+      if (m_filled.pop(m_current) == false)
+      {
+        setg(nullptr, nullptr, nullptr);
+
+        if (m_error != nullptr)
+          std::rethrow_exception(m_error);
+
+        return traits_type::eof();
+      }
+
+      char* data{m_current->data.get()};
+      setg(data, data, data + m_current->size);
+      return traits_type::to_int_type(*gptr());
+    }
+
+    DecompressStream::DecompressStream(const char* fileName, Codec codec)
+      : std::istream{nullptr}
+      , m_buffer{fileName, codec}
+    {
+      rdbuf(&m_buffer);
+      exceptions(std::ios_base::badbit);
+
+      if (m_buffer.isOpen() == false)
+        setstate(std::ios_base::failbit);
+    }
+
+    std::unique_ptr<std::istream> openInput(const char* fileName)
+    {
+      Codec codec{detectCodec(fileName)};
+
+#ifndef NOP_CSV_HAS_ZLIB
+      if (codec == Codec::Gzip)
+        throw err::InvalidArgument{"\033[1;35m[ERROR]\033[0m Cannot open .gz file.\n"
+                                   "\033[1;35m[MESSAGE]\033[0m csvParser was built without zlib."};
+#endif
+
+#ifndef NOP_CSV_HAS_ZSTD
+      if (codec == Codec::Zstd)
+        throw err::InvalidArgument{"\033[1;35m[ERROR]\033[0m Cannot open .zst file.\n"
+                                   "\033[1;35m[MESSAGE]\033[0m csvParser was built without zstd."};
+#endif
+
+      if (codec == Codec::None)
+        return std::make_unique<std::ifstream>(fileName);
+      else
+        return std::make_unique<DecompressStream>(fileName, codec);
+    }
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
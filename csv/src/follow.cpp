@@ -0,0 +1,178 @@
+#include <thread>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <fmt/format.h>
+#include "follow.hpp"
+#include "exception.hpp"
+
+#ifdef __linux__
+  #include <sys/inotify.h>
+#endif
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    FollowBuf::FollowBuf(const char* fileName,
+                         const std::atomic<bool>& stop,
+                         IdleHandler idle,
+                         std::chrono::milliseconds interval)
+      : m_file{::open(fileName, O_RDONLY | O_CLOEXEC)}
+      , m_notify{-1}
+      , m_offset{0}
+      , m_buffer{std::make_unique<char[]>(BufferSize)}
+      , m_stop{&stop}
+      , m_interval{interval}
+      , m_idle{std::move(idle)}
+    {
+#ifdef __linux__
+      if (m_file < 0)
+        return;
+
+      m_notify = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+      /* Without a watch the polling fallback is used */
+      if (m_notify >= 0 && ::inotify_add_watch(m_notify, fileName, IN_MODIFY | IN_CLOSE_WRITE) < 0)
+      {
+        ::close(m_notify);
+        m_notify = -1;
+      }
+#endif
+    }
+
+    FollowBuf::~FollowBuf()
+    {
+      if (m_notify >= 0)
+        ::close(m_notify);
+
+      if (m_file >= 0)
+        ::close(m_file);
+    }
+
+    bool FollowBuf::isOpen() const noexcept
+    {
+      return m_file >= 0;
+    }
+
+    bool FollowBuf::waitForGrowth()
+    {
+      if (m_idle)
+        m_idle();
+
+      while (m_stop->load(std::memory_order_acquire) == false)
+      {
+        if (m_notify >= 0)
+        {
+          pollfd descriptor{m_notify, POLLIN, 0};
+
+          if (::poll(&descriptor, 1UL, static_cast<int32_t>(m_interval.count())) > 0)
+          {
+            char events[4096];
+
+            while (::read(m_notify, events, sizeof(events)) > 0)
+              continue;
+          }
+        }
+        else
+          std::this_thread::sleep_for(m_interval);
+
+        struct stat status{};
+
+        if (::fstat(m_file, &status) != 0)
+          throw err::SystemError{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Cannot stat followed file.\n"
+                "\033[1;35m[MESSAGE]\033[0m {}"
+                , std::strerror(errno))};
+
+        if (status.st_size > m_offset)
+          return true;
+
+        if (status.st_size < m_offset)
+          throw err::RuntimeError{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Followed file was truncated.\n"
+                "\033[1;35m[MESSAGE]\033[0m Read offset : {}, file size : {}"
+                , m_offset
+                , status.st_size)};
+      }
+
+      return false;
+    }
+
+    FollowBuf::int_type FollowBuf::underflow()
+    {
+      if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+      for (;;)
+      {
+        ssize_t size{::read(m_file, m_buffer.get(), BufferSize)};
+
+        if (size > 0)
+        {
+          m_offset += size;
+          setg(m_buffer.get(), m_buffer.get(), m_buffer.get() + size);
+          return traits_type::to_int_type(*gptr());
+        }
+
+        if (size < 0 && errno == EINTR)
+          continue;
+
+        if (size < 0)
+          throw err::SystemError{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Cannot read followed file.\n"
+                "\033[1;35m[MESSAGE]\033[0m {}"
+                , std::strerror(errno))};
+
+        if (waitForGrowth() == false)
+          return traits_type::eof();
+      }
+    }
+
+    FollowBuf::pos_type FollowBuf::seekoff(off_type offset,
+                                           std::ios_base::seekdir direction,
+                                           std::ios_base::openmode mode)
+    {
+      /* Logical position: bytes already handed to the reader */
+      off_type current{m_offset - (egptr() - gptr())};
+
+      if (direction == std::ios_base::cur)
+        return offset == 0 ? pos_type{current} : seekpos(pos_type{current + offset}, mode);
+      else if (direction == std::ios_base::beg)
+        return seekpos(pos_type{offset}, mode);
+      else
+        return pos_type{off_type{-1}};
+    }
+
+    FollowBuf::pos_type FollowBuf::seekpos(pos_type position, std::ios_base::openmode mode)
+    {
+      if ((mode & std::ios_base::in) == 0 || ::lseek(m_file, off_type{position}, SEEK_SET) < 0)
+        return pos_type{off_type{-1}};
+
+      m_offset = off_type{position};
+      setg(m_buffer.get(), m_buffer.get(), m_buffer.get());
+      return position;
+    }
+
+    FollowStream::FollowStream(const char* fileName,
+                               const std::atomic<bool>& stop,
+                               FollowBuf::IdleHandler idle,
+                               std::chrono::milliseconds interval)
+      : std::istream{nullptr}
+      , m_buffer{fileName, stop, std::move(idle), interval}
+    {
+      rdbuf(&m_buffer);
+      exceptions(std::ios_base::badbit);
+
+      if (m_buffer.isOpen() == false)
+        setstate(std::ios_base::failbit);
+    }
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <memory>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <fmt/format.h>
+#include "ingest.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    /* Returns the offset just past the first row symbol at or after position, or size */
+    [[nodiscard]] static uint64_t findRowEnd(int32_t file, uint64_t position, uint64_t size, char row, char* window, size_t windowSize)
+    {
+      while (position < size)
+      {
+        ssize_t read{::pread(file, window, std::min<uint64_t>(windowSize, size - position), static_cast<off_t>(position))};
+
+        if (read < 0 && errno == EINTR)
+          continue;
+
+        if (read <= 0)
+          throw err::SystemError{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Cannot read csv file.\n"
+                "\033[1;35m[MESSAGE]\033[0m {}"
+                , std::strerror(errno))};
+
+        const void* found{std::memchr(window, row, static_cast<size_t>(read))};
+
+        if (found != nullptr)
+          return position + static_cast<uint64_t>(static_cast<const char*>(found) - window) + 1UL;
+
+        position += static_cast<uint64_t>(read);
+      }
+
+      return size;
+    }
+
+    std::vector<FileChunk> splitFiles(const std::vector<std::string>& files, uint64_t chunkSize, char row)
+    {
+      constexpr size_t WindowSize{1UL << 16};
+
+      std::vector<FileChunk> chunks;
+      auto window{std::make_unique<char[]>(WindowSize)};
+
+      for (const auto& fileName : files)
+      {
+        struct stat status{};
+
+        if (::stat(fileName.c_str(), &status) != 0)
+          throw err::InvalidArgument{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Cannot open csv file.\n"
+                "\033[1;35m[MESSAGE]\033[0m Path : {}"
+                , fileName)};
+
+        uint64_t size{static_cast<uint64_t>(status.st_size)};
+
+        if (chunkSize == 0UL || size <= chunkSize || detectCodec(fileName) != Codec::None)
+        {
+          chunks.push_back(FileChunk{fileName, 0UL, size, true});
+          continue;
+        }
+
+        int32_t file{::open(fileName.c_str(), O_RDONLY | O_CLOEXEC)};
+
+        if (file < 0)
+          throw err::InvalidArgument{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Cannot open csv file.\n"
+                "\033[1;35m[MESSAGE]\033[0m Path : {}"
+                , fileName)};
+
+        try
+        {
+          for (uint64_t begin{}; begin < size;)
+          {
+            uint64_t end{size - begin <= chunkSize ? size : findRowEnd(file, begin + chunkSize, size, row, window.get(), WindowSize)};
+            chunks.push_back(FileChunk{fileName, begin, end, false});
+            begin = end;
+          }
+        }
+        catch (...)
+        {
+          ::close(file);
+          throw;
+        }
+
+        ::close(file);
+      }
+
+      /* Largest tasks first, so the smallest ones fill the gaps at the end */
+      std::stable_sort(chunks.begin(), chunks.end(), [](const FileChunk& lhs, const FileChunk& rhs)
+      {
+        return lhs.size() > rhs.size();
+      });
+
+      return chunks;
+    }
+
+    std::vector<FileChunk> splitRecords(const std::vector<std::string>& files, uint64_t chunkSize, uint64_t recordSize)
+    {
+      std::vector<FileChunk> chunks;
+      uint64_t step{std::max<uint64_t>(chunkSize / recordSize, 1UL) * recordSize};
+
+      for (const auto& fileName : files)
+      {
+        struct stat status{};
+
+        if (::stat(fileName.c_str(), &status) != 0)
+          throw err::InvalidArgument{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Cannot open fixed-width file.\n"
+                "\033[1;35m[MESSAGE]\033[0m Path : {}"
+                , fileName)};
+
+        uint64_t size{static_cast<uint64_t>(status.st_size)};
+
+        if (chunkSize == 0UL || size <= chunkSize || detectCodec(fileName) != Codec::None)
+        {
+          chunks.push_back(FileChunk{fileName, 0UL, size, true});
+          continue;
+        }
+
+        for (uint64_t begin{}; begin < size; begin += step)
+          chunks.push_back(FileChunk{fileName, begin, std::min(begin + step, size), false});
+      }
+
+      std::stable_sort(chunks.begin(), chunks.end(), [](const FileChunk& lhs, const FileChunk& rhs)
+      {
+        return lhs.size() > rhs.size();
+      });
+
+      return chunks;
+    }
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
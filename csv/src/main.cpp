@@ -1,6 +1,67 @@
 #include <iostream>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <optional>
+#include <filesystem>
+#include <mutex>
+#include <thread>
 #include "parser.hpp"
+#include "pipeline.hpp"
+#include "writer.hpp"
 #include "command.hpp"
+#include "decompress.hpp"
+#include "follow.hpp"
+#include "ingest.hpp"
+#include "sort.hpp"
+#include "join.hpp"
+#include "profile.hpp"
+#include "schema.hpp"
+
+static std::atomic<bool> followStop{false};
+
+template<size_t Column, class Input, class Output>
+static void sortRows(Input& prs, Output& out, const csv::cmd::DataHandler& inputData)
+{
+  nop::csv::ThreadPool pool{std::max<size_t>(inputData.getThreads(), 1UL)};
+  nop::csv::ExternalSorter<Column, int32_t, std::string> sorter{
+      pool,
+      inputData.getMemory() << 20,
+      inputData.getTempDir() != nullptr ? inputData.getTempDir() : nop::csv::defaultSpillDirectory()};
+
+  for (auto&& i : prs)
+    sorter.push(std::move(i));
+
+  for (auto& i : sorter.sorted())
+    out << i;
+}
+
+template<size_t Column>
+static void joinRows(std::istream& in, const csv::cmd::DataHandler& inputData)
+{
+  using Row = std::tuple<int32_t, std::string>;
+
+  nop::csv::Writer<nop::csv::DefaultCfg, int32_t, std::string, int32_t, std::string> out{STDOUT_FILENO};
+  nop::csv::HashJoin<Column, Column, Row, Row> join{
+      inputData.getMemory() << 20,
+      inputData.getTempDir() != nullptr ? inputData.getTempDir() : nop::csv::defaultSpillDirectory()};
+  auto joined{nop::csv::openInput(inputData.getJoinFile())};
+
+  /* The smaller file is the build side, stdin always streams (a missing file fails in its parser) */
+  std::error_code code;
+  bool swap{inputData.isStdin() == false &&
+            std::filesystem::file_size(inputData.getFileName(), code) < std::filesystem::file_size(inputData.getJoinFile(), code)};
+  nop::csv::Parser<nop::csv::DefaultCfg, int32_t, std::string> build{swap == true ? in : *joined, inputData.getSkipLines()};
+  nop::csv::Parser<nop::csv::DefaultCfg, int32_t, std::string> probe{swap == true ? *joined : in, inputData.getSkipLines()};
+
+  join.build(build);
+
+  /* Columns of the input file always come first */
+  for (auto [probeRow, buildRow] : join.probe(probe))
+    out << (swap == true ? std::tuple_cat(buildRow, probeRow) : std::tuple_cat(probeRow, buildRow));
+
+  out.flush();
+}
 
 int32_t main(int32_t argc, char* argv[])
 {
@@ -9,11 +70,141 @@ int32_t main(int32_t argc, char* argv[])
   try
   {
     csv::cmd::DataHandler inputData{argc, argv};
-    std::ifstream in{inputData.getFileName()};
-    nop::csv::Parser<nop::csv::DefaultCfg, int32_t, std::string> prs{in, inputData.getSkipLines()};
 
-    for (auto&& i : prs)
-      std::cout << i << '\n';
+    if (inputData.isProfile() == true)
+    {
+      nop::csv::Profiler<nop::csv::DefaultCfg, int32_t, std::string> profiler;
+
+      if (inputData.isMultiFile() == true)
+      {
+        nop::csv::ThreadPool pool{inputData.getThreads() > 0UL ? inputData.getThreads() : std::thread::hardware_concurrency()};
+        auto chunks{nop::csv::splitFiles(inputData.getFiles(), inputData.getChunkSize() << 20, nop::csv::DefaultCfg::Symbol::Row)};
+
+        profiler = nop::csv::profileFiles<nop::csv::DefaultCfg, int32_t, std::string>(chunks, inputData.getSkipLines(), pool);
+      }
+      else if (inputData.isStdin() == true)
+        profiler.consume(std::cin, inputData.getSkipLines());
+      else
+        profiler.consume(*nop::csv::openInput(inputData.getFileName()), inputData.getSkipLines());
+
+      fmt::print("{}", profiler.report());
+      return EXIT_SUCCESS;
+    }
+
+    if (inputData.isMultiFile() == true)
+    {
+      std::mutex lock;
+      nop::csv::ThreadPool pool{inputData.getThreads() > 0UL ? inputData.getThreads() : std::thread::hardware_concurrency()};
+      auto chunks{nop::csv::splitFiles(inputData.getFiles(), inputData.getChunkSize() << 20, nop::csv::DefaultCfg::Symbol::Row)};
+
+      static_cast<void>(nop::csv::ingestFiles<nop::csv::DefaultCfg, int32_t, std::string>(chunks, inputData.getSkipLines(), pool, STDOUT_FILENO, lock));
+      return EXIT_SUCCESS;
+    }
+
+    nop::csv::Writer<nop::csv::DefaultCfg, int32_t, std::string> out{STDOUT_FILENO};
+    std::unique_ptr<std::istream> file;
+    std::istream* in{&std::cin};
+
+    if (inputData.isFollow() == true)
+    {
+      std::signal(SIGINT, [](int32_t) { followStop.store(true); });
+      std::signal(SIGTERM, [](int32_t) { followStop.store(true); });
+      file = std::make_unique<nop::csv::FollowStream>(inputData.getFileName(), followStop, [&out] { out.flush(); });
+      in = file.get();
+    }
+    else if (inputData.isStdin() == false)
+    {
+      file = nop::csv::openInput(inputData.getFileName());
+      in = file.get();
+    }
+
+    if (inputData.isInfer() == true)
+    {
+      nop::csv::DynamicParser<nop::csv::DefaultCfg> prs{*in, inputData.getSkipLines(), inputData.getSample() << 10};
+      nop::csv::Writer<nop::csv::DefaultCfg> rows{STDOUT_FILENO};
+      std::string schema;
+
+      for (const auto& type : prs.schema())
+        schema += fmt::format("{}{}", schema.empty() == true ? "" : ",", nop::csv::typeName(type));
+
+      std::cerr << "Schema: " << schema << '\n';
+
+      for (const auto& i : prs)
+        rows << i;
+
+      rows.flush();
+      return EXIT_SUCCESS;
+    }
+
+    if (inputData.getJoinFile() != nullptr)
+    {
+      switch (inputData.getJoinColumn())
+      {
+        case 1UL:
+          joinRows<0UL>(*in, inputData);
+          break;
+        case 2UL:
+          joinRows<1UL>(*in, inputData);
+          break;
+        default:
+          throw nop::err::InvalidArgument{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Invalid join column.\n"
+                "\033[1;35m[MESSAGE]\033[0m Column : {}, number of columns : 2"
+                , inputData.getJoinColumn())};
+      }
+
+      return EXIT_SUCCESS;
+    }
+
+    auto print{[&out, &inputData](auto& prs)
+    {
+      switch (inputData.getSortColumn())
+      {
+        case 0UL:
+          for (auto&& i : prs)
+            out << i;
+          break;
+        case 1UL:
+          sortRows<0UL>(prs, out, inputData);
+          break;
+        case 2UL:
+          sortRows<1UL>(prs, out, inputData);
+          break;
+        default:
+          throw nop::err::InvalidArgument{fmt::format(
+                "\033[1;35m[ERROR]\033[0m Invalid sort column.\n"
+                "\033[1;35m[MESSAGE]\033[0m Column : {}, number of columns : 2"
+                , inputData.getSortColumn())};
+      }
+    }};
+
+    /* Batching would hold back rows of a followed file, and checkpoints need the exact row offset */
+    if (inputData.getThreads() > 0UL && inputData.isFollow() == false && inputData.getCheckpoint() == nullptr)
+    {
+      nop::csv::PipelineParser<nop::csv::DefaultCfg, int32_t, std::string> prs{*in, inputData.getSkipLines(), inputData.getThreads()};
+      print(prs);
+    }
+    else
+    {
+      const char* checkpoint{inputData.getCheckpoint()};
+      std::optional<nop::csv::Parser<nop::csv::DefaultCfg, int32_t, std::string>> prs;
+
+      if (checkpoint != nullptr && std::filesystem::exists(checkpoint) == true)
+        prs.emplace(*in, nop::csv::Checkpoint::load(checkpoint));
+      else
+        prs.emplace(*in, inputData.getSkipLines());
+
+      if (checkpoint != nullptr)
+        prs->setCheckpoint(checkpoint, inputData.getCheckpointInterval(), [&out] { out.flush(); });
+
+      print(*prs);
+
+      /* A finished file must not be resumed from its last checkpoint */
+      if (checkpoint != nullptr && inputData.isFollow() == false)
+        std::remove(checkpoint);
+    }
+
+    out.flush();
   }
   catch (const nop::err::BaseException& error)
   {
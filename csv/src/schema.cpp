@@ -0,0 +1,88 @@
+#include <array>
+#include <type_traits>
+#include "schema.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    template<typename T>
+    [[nodiscard]] static bool convert(std::string_view field, Value& value)
+    {
+      if constexpr (std::is_same_v<T, std::string> == true)
+      {
+        /* Keep the capacity of the previous row's string */
+        if (auto* text{std::get_if<std::string>(&value)}; text != nullptr)
+          text->assign(field);
+        else
+          value.emplace<std::string>(field);
+      }
+      else if (field.empty() == true)
+        value.emplace<std::monostate>();
+      else
+      {
+        T converted{};
+
+        if (FieldTraits<T>::parse(field, converted) == false)
+          return false;
+
+        value.emplace<T>(converted);
+      }
+
+      return true;
+    }
+
+    static constexpr std::array<Kernel, 5UL> kernels{
+      &convert<int64_t>,
+      &convert<bool>,
+      &convert<double>,
+      &convert<Timestamp>,
+      &convert<std::string>
+    };
+
+    static constexpr std::array<std::string_view, 5UL> typeNames{
+      "int64",
+      "bool",
+      "double",
+      "timestamp",
+      "string"
+    };
+
+    std::string_view typeName(ColumnType type) noexcept
+    {
+      return typeNames[static_cast<size_t>(type)];
+    }
+
+    Kernel kernel(ColumnType type) noexcept
+    {
+      return kernels[static_cast<size_t>(type)];
+    }
+
+    uint32_t acceptedTypes(std::string_view field) noexcept
+    {
+      uint32_t accepted{1U << static_cast<uint32_t>(ColumnType::String)};
+      int64_t integer{};
+      bool boolean{};
+      double floating{};
+      Timestamp timestamp{};
+
+      if (FieldTraits<int64_t>::parse(field, integer) == true)
+        accepted |= 1U << static_cast<uint32_t>(ColumnType::Int64);
+
+      if (FieldTraits<bool>::parse(field, boolean) == true)
+        accepted |= 1U << static_cast<uint32_t>(ColumnType::Bool);
+
+      if (FieldTraits<double>::parse(field, floating) == true)
+        accepted |= 1U << static_cast<uint32_t>(ColumnType::Double);
+
+      if (FieldTraits<Timestamp>::parse(field, timestamp) == true)
+        accepted |= 1U << static_cast<uint32_t>(ColumnType::Timestamp);
+
+      return accepted;
+    }
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
@@ -0,0 +1,115 @@
+#include <bit>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <fmt/format.h>
+#include "sketch.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    HyperLogLog::HyperLogLog() noexcept
+      : m_registers{}
+    {}
+
+    void HyperLogLog::add(uint64_t hash) noexcept
+    {
+      size_t index{hash >> (64U - Precision)};
+
+      /* The guard bit caps the rank for hashes whose remaining bits are all zero */
+      auto rank{static_cast<uint8_t>(std::countl_zero((hash << Precision) | (1UL << (Precision - 1U))) + 1)};
+      m_registers[index] = std::max(m_registers[index], rank);
+    }
+
+    void HyperLogLog::merge(const HyperLogLog& other) noexcept
+    {
+      for (size_t i{}; i < Registers; ++i)
+        m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+    }
+
+    double HyperLogLog::estimate() const noexcept
+    {
+      constexpr double registers{static_cast<double>(Registers)};
+      constexpr double alpha{0.7213 / (1.0 + 1.079 / registers)};
+
+      double sum{};
+      size_t zeros{};
+
+      for (const auto& value : m_registers)
+      {
+        sum += std::ldexp(1.0, -static_cast<int32_t>(value));
+        zeros += value == 0U ? 1UL : 0UL;
+      }
+
+      double estimate{alpha * registers * registers / sum};
+
+      /* Linear counting is more accurate while many registers are still empty */
+      if (estimate <= 2.5 * registers && zeros > 0UL)
+        return registers * std::log(registers / static_cast<double>(zeros));
+
+      return estimate;
+    }
+
+    uint64_t HyperLogLog::hash(std::string_view text) noexcept
+    {
+      uint64_t value{std::hash<std::string_view>{}(text)};
+
+      value ^= value >> 33U;
+      value *= 0xff51afd7ed558ccdUL;
+      value ^= value >> 33U;
+      value *= 0xc4ceb9fe1a85ec53UL;
+      value ^= value >> 33U;
+      return value;
+    }
+
+    LengthHistogram::LengthHistogram() noexcept
+      : m_counts{}
+    {}
+
+    void LengthHistogram::add(size_t length) noexcept
+    {
+      ++m_counts[std::min<size_t>(std::bit_width(length), Buckets - 1UL)];
+    }
+
+    void LengthHistogram::merge(const LengthHistogram& other) noexcept
+    {
+      for (size_t i{}; i < Buckets; ++i)
+        m_counts[i] += other.m_counts[i];
+    }
+
+    uint64_t LengthHistogram::count(size_t bucket) const noexcept
+    {
+      return m_counts[bucket];
+    }
+
+    std::string LengthHistogram::format() const
+    {
+      std::string text;
+
+      for (size_t bucket{}; bucket < Buckets; ++bucket)
+      {
+        if (m_counts[bucket] == 0UL)
+          continue;
+
+        size_t lower{bucket == 0UL ? 0UL : 1UL << (bucket - 1UL)};
+
+        if (text.empty() == false)
+          text += ' ';
+
+        if (bucket + 1UL == Buckets)
+          text += fmt::format("{}+:{}", lower, m_counts[bucket]);
+        else if (bucket <= 1UL)
+          text += fmt::format("{}:{}", lower, m_counts[bucket]);
+        else
+          text += fmt::format("{}-{}:{}", lower, (1UL << bucket) - 1UL, m_counts[bucket]);
+      }
+
+      return text;
+    }
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
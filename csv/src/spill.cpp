@@ -0,0 +1,97 @@
+#include <cstdlib>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <fmt/format.h>
+#include "spill.hpp"
+#include "exception.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    SpillFile::SpillFile(const char* directory)
+      : m_file{nullptr}
+      , m_buffer{std::make_unique<char[]>(BufferSize)}
+    {
+      std::string path{fmt::format("{}/nop-csv-spill-XXXXXX", directory)};
+      int32_t file{::mkstemp(path.data())};
+
+      if (file < 0)
+        throw err::SystemError{fmt::format(
+              "\033[1;35m[ERROR]\033[0m Cannot create spill file.\n"
+              "\033[1;35m[MESSAGE]\033[0m Directory : {}, {}"
+              , directory
+              , std::strerror(errno))};
+
+      ::unlink(path.c_str());
+      m_file = ::fdopen(file, "w+b");
+
+      if (m_file == nullptr)
+      {
+        ::close(file);
+        throw err::SystemError{fmt::format(
+              "\033[1;35m[ERROR]\033[0m Cannot create spill file.\n"
+              "\033[1;35m[MESSAGE]\033[0m {}"
+              , std::strerror(errno))};
+      }
+
+      std::setvbuf(m_file, m_buffer.get(), _IOFBF, BufferSize);
+    }
+
+    SpillFile::~SpillFile()
+    {
+      std::fclose(m_file);
+    }
+
+    void SpillFile::write(const void* data, size_t size)
+    {
+      if (std::fwrite(data, 1UL, size, m_file) != size)
+        throw err::SystemError{fmt::format(
+              "\033[1;35m[ERROR]\033[0m Cannot write spill file.\n"
+              "\033[1;35m[MESSAGE]\033[0m {}"
+              , std::strerror(errno))};
+    }
+
+    bool SpillFile::read(void* data, size_t size)
+    {
+      size_t read{std::fread(data, 1UL, size, m_file)};
+
+      if (read == 0UL && std::feof(m_file) != 0)
+        return false;
+
+      if (read != size)
+        corrupted();
+
+      return true;
+    }
+
+    void SpillFile::corrupted() const
+    {
+      throw err::SystemError{fmt::format(
+            "\033[1;35m[ERROR]\033[0m Cannot read spill file.\n"
+            "\033[1;35m[MESSAGE]\033[0m {}"
+            , std::ferror(m_file) != 0 ? std::strerror(errno) : "Unexpected end of file")};
+    }
+
+    void SpillFile::rewind()
+    {
+      if (std::fflush(m_file) != 0 || std::fseek(m_file, 0L, SEEK_SET) != 0)
+        throw err::SystemError{fmt::format(
+              "\033[1;35m[ERROR]\033[0m Cannot rewind spill file.\n"
+              "\033[1;35m[MESSAGE]\033[0m {}"
+              , std::strerror(errno))};
+    }
+
+    const char* defaultSpillDirectory() noexcept
+    {
+      const char* directory{std::getenv("TMPDIR")};
+      return directory != nullptr && *directory != '\0' ? directory : "/tmp";
+    }
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
@@ -1,6 +1,37 @@
 #include <gtest/gtest.h>
 #include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <ranges>
 #include "parser.hpp"
+#include "pipeline.hpp"
+#include "decompress.hpp"
+#include "follow.hpp"
+#include "checkpoint.hpp"
+#include "writer.hpp"
+#include "ingest.hpp"
+#include "sort.hpp"
+#include "join.hpp"
+#include "static_parser.hpp"
+#include "utf8.hpp"
+#include "datetime.hpp"
+#include "sketch.hpp"
+#include "profile.hpp"
+#include "schema.hpp"
+#include "fixed_width.hpp"
+#include <random>
+#include <set>
+#include <algorithm>
+#include <filesystem>
+#include <array>
+#include <bit>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#ifdef NOP_CSV_HAS_ZLIB
+  #include <zlib.h>
+#endif
 
 TEST(TEST_PARSER, VALID_FILE1)
 {
@@ -148,3 +179,1015 @@ TEST(TEST_PARSER, INVALID_FILE_FORMAT3)
       }
       , nop::err::FormatError);
 }
+
+#ifdef NOP_CSV_HAS_ZLIB
+TEST(TEST_PARSER, GZIP_FILE)
+{
+  auto in{nop::csv::openInput("../csv_tests/test9.csv.gz")};
+  nop::csv::Parser<nop::csv::DefaultCfg, std::string, int32_t, std::string> prs{*in, 1};
+  std::vector<std::tuple<std::string, int32_t, std::string>> vals{
+                                     {"another1", 120, "another1"},
+                                     {"another2", 52, "another2"},
+                                     {"another3", 60, "another3"}};
+  size_t counter{};
+  for (auto&& t : prs)
+  {
+    EXPECT_EQ(vals[counter], t);
+    ++counter;
+  }
+  EXPECT_EQ(counter, vals.size());
+}
+
+TEST(TEST_PARSER, GZIP_MULTIPLE_BLOCKS)
+{
+  constexpr int32_t rows{100000};
+  gzFile out{gzopen("test_blocks.csv.gz", "wb")};
+  ASSERT_NE(out, nullptr);
+  gzprintf(out, "Column1,Column2\n");
+  for (int32_t i{}; i < rows; ++i)
+    gzprintf(out, "%d,\"row %d\"\n", i, i);
+  gzclose(out);
+
+  auto in{nop::csv::openInput("test_blocks.csv.gz")};
+  nop::csv::Parser<nop::csv::DefaultCfg, int32_t, std::string> prs{*in, 1};
+  int32_t counter{};
+  for (auto&& t : prs)
+  {
+    EXPECT_EQ(std::make_tuple(counter, fmt::format("row {}", counter)), t);
+    ++counter;
+  }
+  EXPECT_EQ(counter, rows);
+}
+
+TEST(TEST_PARSER, GZIP_MISSING_FILE)
+{
+  auto in{nop::csv::openInput("../csv_tests/test4.csv.gz")};
+  EXPECT_THROW((nop::csv::Parser<nop::csv::DefaultCfg, int32_t, std::string>{*in, 0})
+               , nop::err::InvalidArgument);
+}
+
+TEST(TEST_PARSER, GZIP_CORRUPTED_FILE)
+{
+  nop::csv::DecompressStream in{"../csv_tests/test1.csv", nop::csv::Codec::Gzip};
+  nop::csv::Parser<nop::csv::DefaultCfg, int32_t, std::string> prs{in, 0};
+  EXPECT_THROW(
+      {
+        auto&& e{prs.end()};
+        for (auto&& b{prs.begin()}; b != e; ++b)
+          asm volatile ("");
+      }
+      , nop::err::FormatError);
+}
+#endif
+
+TEST(TEST_PIPELINE, VALID_FILE)
+{
+  std::ifstream in{"../csv_tests/test2.csv"};
+  nop::csv::PipelineParser<nop::csv::DefaultCfg, std::string, int32_t, std::string> prs{in, 1, 2};
+  std::vector<std::tuple<std::string, int32_t, std::string>> vals{
+                                     {"another1", 120, "another1"},
+                                     {"another2", 52, "another2"},
+                                     {"another3", 60, "another3"}};
+  size_t counter{};
+  for (auto&& t : prs)
+  {
+    EXPECT_EQ(vals[counter], t);
+    ++counter;
+  }
+  EXPECT_EQ(counter, vals.size());
+}
+
+TEST(TEST_PIPELINE, CONFIGURATION)
+{
+  std::ifstream in{"../csv_tests/test8.csv"};
+
+  struct MyCfg
+  {
+  public:
+    enum Symbol : char
+    {
+      Column = '.',
+      Row = '*',
+      Escape = '$'
+    };
+  };
+
+  nop::csv::PipelineParser<MyCfg, int32_t, std::string> prs{in, 1, 1};
+  std::vector<std::tuple<int32_t, std::string>> vals{{52, "another2\n"}};
+  size_t counter{};
+  for (auto&& t : prs)
+  {
+    EXPECT_EQ(vals[counter], t);
+    ++counter;
+  }
+  EXPECT_EQ(counter, vals.size());
+}
+
+TEST(TEST_PIPELINE, ROW_ORDER)
+{
+  constexpr int32_t rows{200000};
+  std::stringstream in;
+  for (int32_t i{}; i < rows; ++i)
+    in << i << ",\"row," << i << "\"\n";
+
+  nop::csv::PipelineParser<nop::csv::DefaultCfg, int32_t, std::string> prs{in, 0, 4};
+  int32_t counter{};
+  for (auto&& t : prs)
+  {
+    EXPECT_EQ(std::make_tuple(counter, fmt::format("row,{}", counter)), t);
+    ++counter;
+  }
+  EXPECT_EQ(counter, rows);
+}
+
+TEST(TEST_PIPELINE, INVALID_FILE_FORMAT)
+{
+  for (const char* fileName : {"../csv_tests/test6.csv", "../csv_tests/test7.csv"})
+  {
+    std::ifstream in{fileName};
+    nop::csv::PipelineParser<nop::csv::DefaultCfg, int32_t, std::string> prs{in, 1, 2};
+    EXPECT_THROW(
+        {
+          auto&& e{prs.end()};
+          for (auto&& b{prs.begin()}; b != e; ++b)
+            asm volatile ("");
+        }
+        , nop::err::FormatError);
+  }
+}
+
+TEST(TEST_FOLLOW, APPENDED_ROWS)
+{
+  {
+    std::ofstream out{"test_follow.csv", std::ios_base::trunc};
+    out << "Column1,Column2\n1,a\n2,bb";
+  }
+
+  std::atomic<bool> stop{false};
+  std::thread writer{[&stop]
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    {
+      std::ofstream out{"test_follow.csv", std::ios_base::app};
+      out << "b\n3,c\n";
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    stop.store(true);
+  }};
+
+  nop::csv::FollowStream in{"test_follow.csv", stop, {}, std::chrono::milliseconds{20}};
+  nop::csv::Parser<nop::csv::DefaultCfg, int32_t, std::string> prs{in, 1};
+  std::vector<std::tuple<int32_t, std::string>> vals{{1, "a"}, {2, "bbb"}, {3, "c"}};
+  size_t counter{};
+  for (auto&& t : prs)
+  {
+    if (counter < vals.size())
+    {
+      EXPECT_EQ(vals[counter], t);
+    }
+    ++counter;
+  }
+  writer.join();
+  EXPECT_EQ(counter, vals.size());
+}
+
+TEST(TEST_FOLLOW, INVALID_FILE)
+{
+  std::atomic<bool> stop{false};
+  nop::csv::FollowStream in{"../csv_tests/test4.csv", stop};
+  EXPECT_THROW((nop::csv::Parser<nop::csv::DefaultCfg, int32_t, std::string>{in, 0})
+               , nop::err::InvalidArgument);
+}
+
+TEST(TEST_CHECKPOINT, RESUME)
+{
+  using Row = std::tuple<std::string, int32_t, std::string>;
+  std::vector<Row> all;
+  {
+    std::ifstream in{"../csv_tests/test5.csv"};
+    nop::csv::Parser<nop::csv::DefaultCfg, std::string, int32_t, std::string> prs{in, 1};
+    for (auto&& t : prs)
+      all.push_back(t);
+  }
+
+  std::remove("test_resume.ckpt");
+  {
+    std::ifstream in{"../csv_tests/test5.csv"};
+    nop::csv::Parser<nop::csv::DefaultCfg, std::string, int32_t, std::string> prs{in, 1};
+    prs.setCheckpoint("test_resume.ckpt", 10);
+    size_t counter{};
+    for (auto&& t : prs)
+    {
+      EXPECT_EQ(all[counter], t);
+      if (++counter == 25)
+        break;
+    }
+  }
+
+  auto checkpoint{nop::csv::Checkpoint::load("test_resume.ckpt")};
+  EXPECT_EQ(checkpoint.row, 21UL);
+  EXPECT_FALSE(checkpoint.inQuote);
+
+  std::ifstream in{"../csv_tests/test5.csv"};
+  nop::csv::Parser<nop::csv::DefaultCfg, std::string, int32_t, std::string> prs{in, checkpoint};
+  size_t counter{checkpoint.row - 1UL};
+  for (auto&& t : prs)
+  {
+    ASSERT_LT(counter, all.size());
+    EXPECT_EQ(all[counter], t);
+    ++counter;
+  }
+  EXPECT_EQ(counter, all.size());
+}
+
+TEST(TEST_CHECKPOINT, ABRUPT_STOP)
+{
+  std::remove("test_abrupt.ckpt");
+  std::remove("test_abrupt.csv");
+
+  /* The child dies without unwinding, so anything still buffered in the Writer is lost */
+  pid_t child{fork()};
+  ASSERT_NE(child, -1);
+  if (child == 0)
+  {
+    std::ifstream in{"../csv_tests/test5.csv"};
+    nop::csv::Parser<nop::csv::DefaultCfg, std::string, int32_t, std::string> prs{in, 1};
+    nop::csv::Writer<nop::csv::DefaultCfg, std::string, int32_t, std::string> out{"test_abrupt.csv"};
+    prs.setCheckpoint("test_abrupt.ckpt", 10, [&out] { out.flush(); });
+    size_t counter{};
+    for (auto&& t : prs)
+    {
+      out << t;
+      if (++counter == 25)
+        break;
+    }
+    _exit(0);
+  }
+
+  int status{};
+  ASSERT_EQ(waitpid(child, &status, 0), child);
+  ASSERT_TRUE(WIFEXITED(status));
+
+  auto checkpoint{nop::csv::Checkpoint::load("test_abrupt.ckpt")};
+  EXPECT_EQ(checkpoint.row, 21UL);
+
+  /* Rows 2..checkpoint.row - 1 were handed out before the save and must be on disk */
+  std::ifstream in{"test_abrupt.csv"};
+  nop::csv::Parser<nop::csv::DefaultCfg, std::string, int32_t, std::string> prs{in, 0};
+  size_t written{};
+  for ([[maybe_unused]] auto&& t : prs)
+    ++written;
+  EXPECT_GE(written, checkpoint.row - 1UL);
+}
+
+TEST(TEST_CHECKPOINT, INVALID_FILE)
+{
+  EXPECT_THROW(static_cast<void>(nop::csv::Checkpoint::load("../csv_tests/test1.csv")), nop::err::FormatError);
+  EXPECT_THROW(static_cast<void>(nop::csv::Checkpoint::load("../csv_tests/test4.ckpt")), nop::err::InvalidArgument);
+}
+
+TEST(TEST_WRITER, ROUND_TRIP)
+{
+  using Row = std::tuple<int32_t, std::string, double>;
+  std::vector<Row> vals{{120, "another1", 0.5},
+                        {-52, "with,column", 1e-7},
+                        {0, "with\nrow", -3.25},
+                        {7, "say \"hi\"", 1.5},
+                        {8, "a\"b", -2.0},
+                        {9, "\"", 0.0},
+                        {10, "\"\"edge,\"\"", 4.0}};
+  {
+    nop::csv::Writer<nop::csv::DefaultCfg, int32_t, std::string, double> out{"test_writer.csv"};
+    out << Row{1, "Column", 2.0};
+    for (const auto& row : vals)
+      out << row;
+  }
+
+  std::ifstream in{"test_writer.csv"};
+  nop::csv::PipelineParser<nop::csv::DefaultCfg, int32_t, std::string, double> prs{in, 1, 1};
+  size_t counter{};
+  for (auto&& t : prs)
+  {
+    EXPECT_EQ(vals[counter], t);
+    ++counter;
+  }
+  EXPECT_EQ(counter, vals.size());
+}
+
+TEST(TEST_WRITER, QUOTING)
+{
+  {
+    nop::csv::Writer<nop::csv::TsvCfg, std::string, int64_t, bool> out{"test_writer.tsv"};
+    out << std::make_tuple(std::string{"plain,text"}, int64_t{-9000000000}, true);
+    out << std::make_tuple(std::string{"tab\there"}, int64_t{1}, false);
+    out << std::make_tuple(std::string{"say \"hi\""}, int64_t{2}, false);
+  }
+
+  std::ifstream in{"test_writer.tsv"};
+  std::stringstream text;
+  text << in.rdbuf();
+  EXPECT_EQ(text.str(), "plain,text\t-9000000000\t1\n"
+                        "\"tab\there\"\t1\t0\n"
+                        "\"say \"\"hi\"\"\"\t2\t0\n");
+
+  in.clear();
+  in.seekg(0);
+  nop::csv::Parser<nop::csv::TsvCfg, std::string, int64_t, bool> prs{in, 0};
+  std::vector<std::string> words;
+  for (auto&& t : prs)
+    words.push_back(std::get<0>(t));
+  EXPECT_EQ(words, (std::vector<std::string>{"plain,text", "tab\there", "say \"hi\""}));
+}
+
+TEST(TEST_GENERATOR, RANGE_ADAPTORS)
+{
+  std::ifstream in{"../csv_tests/test5.csv"};
+  nop::csv::Parser<nop::csv::DefaultCfg, std::string, int32_t, std::string> prs{in, 1};
+  static_assert(std::ranges::input_range<decltype(prs.rows())>);
+  static_assert(std::ranges::view<decltype(prs.rows())>);
+
+  std::vector<std::string> words;
+  for (auto&& word : prs.rows()
+                     | std::views::filter([](const auto& t) { return std::get<1>(t) >= 20; })
+                     | std::views::transform([](const auto& t) -> const std::string& { return std::get<0>(t); })
+                     | std::views::take(3))
+    words.push_back(word);
+
+  EXPECT_EQ(words, (std::vector<std::string>{"size_type", "bitset", "num_bits"}));
+}
+
+TEST(TEST_GENERATOR, PIPELINE_BATCHES)
+{
+  constexpr int32_t rows{100000};
+  std::stringstream in;
+  for (int32_t i{}; i < rows; ++i)
+    in << i << ",row" << i << '\n';
+
+  nop::csv::PipelineParser<nop::csv::DefaultCfg, int32_t, std::string> prs{in, 0, 3};
+  int32_t counter{};
+  size_t batches{};
+  for (auto batch : prs.batches())
+  {
+    for (const auto& t : batch)
+    {
+      EXPECT_EQ(std::get<0>(t), counter);
+      ++counter;
+    }
+    ++batches;
+  }
+  EXPECT_EQ(counter, rows);
+  EXPECT_GT(batches, 1UL);
+}
+
+TEST(TEST_GENERATOR, FORMAT_ERROR)
+{
+  std::ifstream in{"../csv_tests/test7.csv"};
+  nop::csv::PipelineParser<nop::csv::DefaultCfg, int32_t, std::string> prs{in, 1, 2};
+  EXPECT_THROW(
+      {
+        for (auto&& t : prs.rows() | std::views::drop(1))
+          static_cast<void>(t);
+      }
+      , nop::err::FormatError);
+}
+
+TEST(TEST_INGEST, CHUNK_BOUNDARIES)
+{
+  const std::string fileName{"ingest_chunks.csv"};
+  {
+    std::ofstream out{fileName};
+    for (int32_t i{}; i < 10000; ++i)
+      out << i << ",row" << i << '\n';
+  }
+
+  auto chunks{nop::csv::splitFiles({fileName}, 4096, '\n')};
+  std::ranges::sort(chunks, {}, &nop::csv::FileChunk::begin);
+  EXPECT_GT(chunks.size(), 1UL);
+
+  std::ifstream in{fileName, std::ios_base::binary};
+  std::string text{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+  uint64_t offset{};
+  for (const auto& chunk : chunks)
+  {
+    EXPECT_EQ(chunk.begin, offset);
+    EXPECT_EQ(text[chunk.end - 1], '\n');
+    offset = chunk.end;
+  }
+  EXPECT_EQ(offset, text.size());
+  std::filesystem::remove(fileName);
+}
+
+TEST(TEST_INGEST, MULTIPLE_FILES)
+{
+  const std::filesystem::path directory{"ingest_files"};
+  std::filesystem::create_directory(directory);
+  std::vector<std::string> files;
+  std::vector<std::tuple<int32_t, std::string>> expected;
+  for (int32_t file{}; file < 5; ++file)
+  {
+    files.push_back((directory / fmt::format("part{}.csv", file)).string());
+    std::ofstream out{files.back()};
+    out << "Column1,Column2\n";
+    for (int32_t i{}; i < (file + 1) * 3000; ++i)
+    {
+      out << file * 100000 + i << ",row" << i << '\n';
+      expected.emplace_back(file * 100000 + i, fmt::format("row{}", i));
+    }
+  }
+
+  const std::string output{"ingest_output.csv"};
+  {
+    int32_t file{::open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+    std::mutex lock;
+    nop::csv::ThreadPool pool{4};
+    auto chunks{nop::csv::splitFiles(files, 8192, '\n')};
+    EXPECT_EQ((nop::csv::ingestFiles<nop::csv::DefaultCfg, int32_t, std::string>(chunks, 1, pool, file, lock)), expected.size());
+    ::close(file);
+  }
+
+  std::ifstream in{output};
+  nop::csv::Parser<nop::csv::DefaultCfg, int32_t, std::string> prs{in, 0};
+  std::vector<std::tuple<int32_t, std::string>> result;
+  for (auto&& t : prs)
+    result.push_back(t);
+  std::ranges::sort(result);
+  std::ranges::sort(expected);
+  EXPECT_EQ(result, expected);
+
+  std::filesystem::remove_all(directory);
+  std::filesystem::remove(output);
+}
+
+TEST(TEST_SORT, LOSER_TREE)
+{
+  for (size_t size{1}; size < 12; ++size)
+  {
+    std::vector<std::vector<int32_t>> runs(size);
+    std::vector<int32_t> expected;
+    for (size_t run{}; run < size; ++run)
+      for (int32_t i{}; i < static_cast<int32_t>(run * 3 + 1); ++i)
+      {
+        runs[run].push_back(i * static_cast<int32_t>(size) + static_cast<int32_t>(run % 4));
+        expected.push_back(runs[run].back());
+      }
+    std::ranges::sort(expected);
+
+    std::vector<size_t> heads(size);
+    nop::csv::LoserTree tree{size, [&](size_t lhs, size_t rhs)
+    {
+      if (heads[lhs] == runs[lhs].size() || heads[rhs] == runs[rhs].size())
+        return heads[rhs] == runs[rhs].size() && heads[lhs] != runs[lhs].size();
+      return runs[lhs][heads[lhs]] < runs[rhs][heads[rhs]];
+    }};
+
+    std::vector<int32_t> merged;
+    for (size_t run{tree.top()}; heads[run] != runs[run].size(); run = tree.top())
+    {
+      merged.push_back(runs[run][heads[run]++]);
+      tree.replay(run);
+    }
+    EXPECT_EQ(merged, expected);
+  }
+}
+
+TEST(TEST_SORT, SPILLED_RUNS)
+{
+  std::mt19937 random{42};
+  std::vector<std::tuple<int32_t, std::string>> rows;
+  for (int32_t i{}; i < 50000; ++i)
+    rows.emplace_back(static_cast<int32_t>(random() % 1000) - 500, std::to_string(i));
+
+  nop::csv::ThreadPool pool{3};
+  nop::csv::ExternalSorter<0, int32_t, std::string> sorter{pool, 1UL << 16, "."};
+  for (const auto& row : rows)
+    sorter.push(row);
+
+  std::vector<std::tuple<int32_t, std::string>> result;
+  for (auto& row : sorter.sorted())
+    result.push_back(row);
+
+  std::ranges::stable_sort(rows, {}, [](const auto& row) { return std::get<0>(row); });
+  EXPECT_EQ(result, rows);
+}
+
+TEST(TEST_SORT, TYPED_KEYS)
+{
+  nop::csv::ThreadPool pool{1};
+  nop::csv::ExternalSorter<0, double, std::string> sorter{pool, 1UL << 20};
+  sorter.push({10.0, "10"});
+  sorter.push({9.5, "9.5"});
+  sorter.push({-1e3, "-1e3"});
+  sorter.push({100.0, "100"});
+
+  std::vector<std::string> keys;
+  for (auto& row : sorter.sorted())
+    keys.push_back(std::get<1>(row));
+  EXPECT_EQ(keys, (std::vector<std::string>{"-1e3", "9.5", "10", "100"}));
+}
+
+TEST(TEST_JOIN, DUPLICATE_KEYS)
+{
+  using Row = std::tuple<int32_t, std::string>;
+  std::stringstream build{"1,one\n2,two\n2,deux\n4,four\n"};
+  std::stringstream probe{"2,b\n3,c\n1,a\n2,bb\n"};
+  nop::csv::Parser<nop::csv::DefaultCfg, int32_t, std::string> buildPrs{build, 0};
+  nop::csv::Parser<nop::csv::DefaultCfg, int32_t, std::string> probePrs{probe, 0};
+
+  nop::csv::HashJoin<0, 0, Row, Row> join{1UL << 20};
+  join.build(buildPrs);
+  std::vector<std::tuple<int32_t, std::string, int32_t, std::string>> result;
+  for (auto [probeRow, buildRow] : join.probe(probePrs))
+    result.push_back(std::tuple_cat(probeRow, buildRow));
+
+  std::ranges::sort(result);
+  EXPECT_EQ(result, (std::vector<std::tuple<int32_t, std::string, int32_t, std::string>>{
+      {1, "a", 1, "one"}, {2, "b", 2, "deux"}, {2, "b", 2, "two"}, {2, "bb", 2, "deux"}, {2, "bb", 2, "two"}}));
+}
+
+TEST(TEST_JOIN, GRACE_PARTITIONS)
+{
+  using Build = std::tuple<std::string, int32_t>;
+  using Probe = std::tuple<int32_t, std::string>;
+  std::vector<Build> buildRows;
+  std::vector<Probe> probeRows;
+  std::vector<std::tuple<int32_t, std::string, int32_t>> expected;
+  for (int32_t i{}; i < 20000; ++i)
+    buildRows.emplace_back(fmt::format("key{}", i), i);
+  for (int32_t i{}; i < 30000; ++i)
+  {
+    probeRows.emplace_back(i, fmt::format("key{}", i * 7 % 25000));
+    if (i * 7 % 25000 < 20000)
+      expected.emplace_back(i, fmt::format("key{}", i * 7 % 25000), i * 7 % 25000);
+  }
+
+  /* A budget far below the build side forces partitioning, and some partitions split again */
+  nop::csv::HashJoin<0, 1, Build, Probe> join{1UL << 15, "."};
+  join.build(buildRows);
+  std::vector<std::tuple<int32_t, std::string, int32_t>> result;
+  for (auto [probeRow, buildRow] : join.probe(probeRows))
+    result.emplace_back(std::get<0>(probeRow), std::get<1>(probeRow), std::get<1>(buildRow));
+
+  std::ranges::sort(result);
+  std::ranges::sort(expected);
+  EXPECT_EQ(result, expected);
+}
+
+TEST(TEST_STATIC, LITERAL_TABLE)
+{
+  static constexpr auto table{nop::csv::parseStatic<nop::csv::DefaultCfg,
+      "120,another1,0.25\n-52,\"another,2\",1e3\n7,x,-1.5e-2", int32_t, std::string_view, double>()};
+
+  static_assert(table.size() == 3);
+  static_assert(std::get<0>(table[1]) == -52);
+  static_assert(std::get<1>(table[1]) == "another,2");
+  static_assert(std::get<2>(table[1]) == 1000.0);
+
+  EXPECT_EQ(std::get<1>(table[0]), "another1");
+  EXPECT_DOUBLE_EQ(std::get<2>(table[0]), 0.25);
+  EXPECT_DOUBLE_EQ(std::get<2>(table[2]), -1.5e-2);
+}
+
+TEST(TEST_STATIC, DOUBLED_ESCAPE)
+{
+  static constexpr auto table{nop::csv::parseStatic<nop::csv::DefaultCfg,
+      "\"say \"\"hi\"\"\",1\n\"a\"\"b\",2\n\"\"\"\",3", std::string_view, int32_t>()};
+
+  static_assert(table.size() == 3);
+  static_assert(std::get<0>(table[0]) == "say \"hi\"");
+  static_assert(std::get<0>(table[1]) == "a\"b");
+  static_assert(std::get<0>(table[2]) == "\"");
+  static_assert(std::get<1>(table[2]) == 3);
+}
+
+TEST(TEST_STATIC, RUNTIME_CONVERSION_MATCHES)
+{
+  static constexpr std::array<std::string_view, 20UL> fields{
+      "0.1", "123.456", "1e22", "2.5e-7", "-9007199254740991", "7.038531e-26", "1e200", "1e300", "1e-300",
+      "2.2250738585072014e-308", "2.2250738585072011e-308", "4.9406564584124654e-324", "1.7976931348623157e308",
+      "1.7976931348623159e308", "1e-400", "9007199254740993", "1.00000000000000011102230246251565404236316680908203125",
+      "-0", "inf", "1.5x"};
+
+  /* Converted during constant evaluation, then checked bit for bit against std::from_chars */
+  static constexpr auto compiled{[]
+  {
+    std::array<std::pair<bool, double>, fields.size()> results{};
+
+    for (size_t i{}; i != fields.size(); ++i)
+      results[i].first = nop::csv::FieldTraits<double>::parse(fields[i], results[i].second);
+
+    return results;
+  }()};
+
+  for (size_t i{}; i != fields.size(); ++i)
+  {
+    double value{};
+    auto [ptr, code]{std::from_chars(fields[i].data(), fields[i].data() + fields[i].size(), value)};
+    bool parsed{code == std::errc{} && ptr == fields[i].data() + fields[i].size()};
+
+    EXPECT_EQ(compiled[i].first, parsed) << fields[i];
+
+    if (parsed == true)
+    {
+      EXPECT_EQ(std::bit_cast<uint64_t>(compiled[i].second), std::bit_cast<uint64_t>(value)) << fields[i];
+    }
+  }
+
+  constexpr auto single{[](std::string_view field)
+  {
+    float value{};
+    return nop::csv::FieldTraits<float>::parse(field, value) == true ? value : -1.0f;
+  }};
+
+  static_assert(single("3.4028235e38") == std::numeric_limits<float>::max());
+  static_assert(single("3.4028236e38") == -1.0f);
+  static_assert(single("1.4e-45") == std::numeric_limits<float>::denorm_min());
+  static_assert(single("16777217") == 16777216.0f);
+
+  constexpr auto integer{[](std::string_view field)
+  {
+    int8_t value{};
+    return nop::csv::FieldTraits<int8_t>::parse(field, value) == true ? value : 0;
+  }};
+
+  static_assert(integer("-128") == -128);
+  static_assert(integer("127") == 127);
+  static_assert(integer("128") == 0);
+}
+
+TEST(TEST_UTF8, VALIDATOR)
+{
+  using namespace std::string_view_literals;
+  const std::string valid{"plain ascii text, \xc3\xa9t\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 \xf4\x8f\xbf\xbf and more ascii"};
+  EXPECT_EQ(nop::csv::validateUtf8(valid), std::string_view::npos);
+
+  for (auto invalid : {"\xc0\xaf"sv, "\xe0\x80\xaf"sv, "\xed\xa0\x80"sv, "\xf4\x90\x80\x80"sv, "\x80"sv, "\xe2\x82"sv})
+  {
+    EXPECT_EQ(nop::csv::validateUtf8(valid + std::string{invalid}), valid.size());
+    EXPECT_EQ(nop::csv::validateUtf8(valid + std::string{invalid} + valid), valid.size());
+  }
+}
+
+TEST(TEST_UTF8, PARSER_POSITION)
+{
+  std::stringstream in{"1,caf\xc3\xa9\n2,ok\n3,bad\xff\n"};
+  nop::csv::Parser<nop::csv::Utf8Cfg, int32_t, std::string> prs{in, 0};
+  size_t rows{};
+  try
+  {
+    for (auto&& t : prs)
+    {
+      static_cast<void>(t);
+      ++rows;
+    }
+    FAIL();
+  }
+  catch (const nop::err::FormatError& error)
+  {
+    EXPECT_NE(std::string{error.what()}.find("<Row:2;Column:3-"), std::string::npos);
+  }
+  EXPECT_EQ(rows, 2UL);
+
+  std::stringstream pipelined{"1,caf\xc3\xa9\n2,ok\n3,bad\xff\n"};
+  nop::csv::PipelineParser<nop::csv::Utf8Cfg, int32_t, std::string> pipeline{pipelined, 0, 1};
+  EXPECT_THROW(
+      {
+        for (auto&& t : pipeline)
+          static_cast<void>(t);
+      }
+      , nop::err::FormatError);
+}
+
+TEST(TEST_DATETIME, TIMESTAMP_FORMATS)
+{
+  using namespace std::chrono;
+  nop::csv::Timestamp value{};
+  const auto expected{sys_days{2026y / October / 17} + 12h + 34min + 56s + 789ms};
+
+  ASSERT_TRUE(nop::csv::FieldTraits<nop::csv::Timestamp>::parse("2026-10-17T12:34:56.789Z", value));
+  EXPECT_EQ(value.value, expected);
+  ASSERT_TRUE(nop::csv::FieldTraits<nop::csv::Timestamp>::parse("2026-10-17 14:34:56.789123+02:00", value));
+  EXPECT_EQ(value.value, expected);
+  ASSERT_TRUE(nop::csv::FieldTraits<nop::csv::Timestamp>::parse("1969-12-31T23:59:59", value));
+  EXPECT_EQ(value.epoch(), -1000);
+
+  for (std::string_view invalid : {"2026-10-17", "2026-13-17T12:34:56Z", "2026-02-29T12:34:56Z", "2026-10-17T24:00:00Z",
+                                   "2026-10-17T12:34:5xZ", "2026-10-17T12-34:56Z", "2026/10/17T12:34:56Z",
+                                   "2026-10-17T12:34:56.Z", "2026-10-17T12:34:56.1234567890Z", "2026-10-17T12:34:56+0200",
+                                   "2026-10-17T12:34:56+99:00", "2026-10-17T12:34:56-24:00"})
+    EXPECT_FALSE(nop::csv::FieldTraits<nop::csv::Timestamp>::parse(invalid, value)) << invalid;
+
+  nop::csv::Date date{};
+  ASSERT_TRUE(nop::csv::FieldTraits<nop::csv::Date>::parse("2024-02-29", date));
+  EXPECT_EQ(date.value, sys_days{2024y / February / 29});
+  EXPECT_FALSE(nop::csv::FieldTraits<nop::csv::Date>::parse("2023-02-29", date));
+  EXPECT_FALSE(nop::csv::FieldTraits<nop::csv::Date>::parse("2024-02-2", date));
+}
+
+TEST(TEST_DATETIME, PARSE_AND_WRITE)
+{
+  const std::string fileName{"datetime_output.csv"};
+  const std::string text{"2026-10-17,2026-10-17T12:34:56.789Z\n1999-01-02,2000-02-29T00:00:00.001Z\n"};
+
+  std::stringstream in{text};
+  nop::csv::Parser<nop::csv::DefaultCfg, nop::csv::Date, nop::csv::Timestamp> prs{in, 0};
+  std::stringstream pipelined{text};
+  nop::csv::PipelineParser<nop::csv::DefaultCfg, nop::csv::Date, nop::csv::Timestamp> pipeline{pipelined, 0, 1};
+  {
+    nop::csv::Writer<nop::csv::DefaultCfg, nop::csv::Date, nop::csv::Timestamp> out{fileName.c_str()};
+    for (auto&& t : prs)
+      out << t;
+  }
+
+  std::ifstream written{fileName};
+  EXPECT_EQ(std::string(std::istreambuf_iterator<char>{written}, std::istreambuf_iterator<char>{}), text);
+
+  std::vector<std::tuple<nop::csv::Date, nop::csv::Timestamp>> rows;
+  for (auto&& t : pipeline)
+    rows.push_back(t);
+  ASSERT_EQ(rows.size(), 2UL);
+  EXPECT_EQ(std::get<0>(rows[1]).value, std::chrono::sys_days{std::chrono::year{1999} / 1 / 2});
+  EXPECT_EQ(std::get<1>(rows[1]).epoch(), 951782400001);
+  std::filesystem::remove(fileName);
+}
+
+TEST(TEST_PROFILE, SKETCHES)
+{
+  nop::csv::HyperLogLog first;
+  nop::csv::HyperLogLog second;
+
+  for (size_t i{}; i < 100000UL; ++i)
+  {
+    const std::string value{std::to_string(i)};
+    (i % 2UL == 0UL ? first : second).add(nop::csv::HyperLogLog::hash(value));
+    first.add(nop::csv::HyperLogLog::hash(value.substr(0UL, 1UL)));
+  }
+
+  EXPECT_NEAR(first.estimate(), 50000.0, 2500.0);
+  first.merge(second);
+  EXPECT_NEAR(first.estimate(), 100000.0, 5000.0);
+
+  nop::csv::HyperLogLog small;
+  for (std::string_view value : {"a", "b", "c", "a"})
+    small.add(nop::csv::HyperLogLog::hash(value));
+  EXPECT_NEAR(small.estimate(), 3.0, 0.1);
+
+  nop::csv::LengthHistogram lengths;
+  for (size_t length : {0UL, 1UL, 2UL, 3UL, 4UL, 100000UL})
+    lengths.add(length);
+  EXPECT_EQ(lengths.count(0UL), 1UL);
+  EXPECT_EQ(lengths.count(2UL), 2UL);
+  EXPECT_EQ(lengths.count(nop::csv::LengthHistogram::Buckets - 1UL), 1UL);
+  EXPECT_EQ(lengths.format(), "0:1 1:1 2-3:2 4-7:1 16384+:1");
+}
+
+TEST(TEST_PROFILE, COLUMN_STATISTICS)
+{
+  const std::string text{"1,\"a,\"\"b\"\"\"\n,xyz\n-7,\nx,\"line\nbreak\"\n42,xyz"};
+
+  nop::csv::Profiler<nop::csv::DefaultCfg, int32_t, std::string> profiler;
+  std::stringstream in{text};
+  profiler.consume(in, 0);
+
+  EXPECT_EQ(profiler.rows(), 5UL);
+  auto& numbers{profiler.column<0UL>()};
+  EXPECT_EQ(numbers.count(), 5UL);
+  EXPECT_EQ(numbers.nulls(), 1UL);
+  EXPECT_EQ(numbers.invalid(), 1UL);
+  EXPECT_EQ(numbers.min(), -7);
+  EXPECT_EQ(numbers.max(), 42);
+
+  auto& strings{profiler.column<1UL>()};
+  EXPECT_EQ(strings.nulls(), 1UL);
+  EXPECT_EQ(strings.min(), "a,\"b\"");
+  EXPECT_EQ(strings.max(), "xyz");
+  EXPECT_NEAR(strings.distinct(), 3.0, 0.1);
+  EXPECT_EQ(strings.lengths().format(), "0:1 2-3:2 4-7:1 8-15:1");
+
+  /* Any split point of the text profiles like a single pass */
+  for (size_t split{}; split <= text.size(); ++split)
+  {
+    nop::csv::Profiler<nop::csv::DefaultCfg, int32_t, std::string> streamed;
+    size_t consumed{streamed.consume(std::string_view{text}.substr(0UL, split), false)};
+    EXPECT_EQ(streamed.consume(std::string_view{text}.substr(consumed), true), text.size() - consumed);
+    EXPECT_EQ(streamed.report(), profiler.report()) << split;
+  }
+
+  nop::csv::Profiler<nop::csv::DefaultCfg, int32_t, std::string> invalid;
+  EXPECT_THROW(static_cast<void>(invalid.consume("1,a,b\n", true)), nop::err::FormatError);
+}
+
+TEST(TEST_PROFILE, MERGED_CHUNKS)
+{
+  const std::string fileName{"profile_chunks.csv"};
+  std::mt19937_64 random{7};
+  int32_t low{INT32_MAX};
+  int32_t high{INT32_MIN};
+  {
+    std::ofstream out{fileName};
+    out << "id,name\n";
+
+    for (size_t i{}; i < 20000UL; ++i)
+    {
+      int32_t value{static_cast<int32_t>(random() % 2000001UL) - 1000000};
+      low = std::min(low, value);
+      high = std::max(high, value);
+      out << value << ",name" << i % 1000UL << '\n';
+    }
+  }
+
+  nop::csv::ThreadPool pool{3UL};
+  auto chunks{nop::csv::splitFiles({fileName}, 4096UL, '\n')};
+  ASSERT_GT(chunks.size(), 10UL);
+  auto profiler{nop::csv::profileFiles<nop::csv::DefaultCfg, int32_t, std::string>(chunks, 1, pool)};
+
+  nop::csv::Profiler<nop::csv::DefaultCfg, int32_t, std::string> single;
+  std::ifstream in{fileName};
+  single.consume(in, 1);
+
+  EXPECT_EQ(profiler.rows(), 20000UL);
+  EXPECT_EQ(profiler.column<0UL>().min(), low);
+  EXPECT_EQ(profiler.column<0UL>().max(), high);
+  EXPECT_EQ(profiler.report(), single.report());
+  EXPECT_NEAR(profiler.column<1UL>().distinct(), 1000.0, 50.0);
+  std::filesystem::remove(fileName);
+}
+
+TEST(TEST_SCHEMA, INFERENCE)
+{
+  using nop::csv::ColumnType;
+
+  const std::string text{"1,1,0.5,true,2026-10-17T12:34:56Z,x,\n"
+                         "-2,2.5,7,false,2026-10-17 12:34:56.5+01:00,\"3\",\n"
+                         ",1e3,,1,,4,\n"
+                         "3,4,5,0,2026,x,"};
+
+  EXPECT_EQ(nop::csv::inferSchema<nop::csv::DefaultCfg>(text, false),
+            (std::vector<ColumnType>{ColumnType::Int64, ColumnType::Double, ColumnType::Double, ColumnType::Bool,
+                                     ColumnType::Timestamp, ColumnType::String, ColumnType::String}));
+
+  /* The cut off last row only counts once the sample is the whole input */
+  EXPECT_EQ(nop::csv::inferSchema<nop::csv::DefaultCfg>(text, true)[4], ColumnType::String);
+  EXPECT_TRUE(nop::csv::inferSchema<nop::csv::DefaultCfg>("", true).empty());
+  EXPECT_THROW(static_cast<void>(nop::csv::inferSchema<nop::csv::DefaultCfg>("1,2\n3\n", true)), nop::err::FormatError);
+}
+
+TEST(TEST_SCHEMA, DYNAMIC_PARSER)
+{
+  std::string text{"id,price,flag,name\n"};
+
+  for (int64_t i{}; i < 20000; ++i)
+    text += fmt::format("{},{}.25,{},\"n,{}\"\n", i * 1000000000LL, i, i % 2 == 0 ? "true" : "false", i);
+
+  std::stringstream in{text};
+  nop::csv::DynamicParser<nop::csv::DefaultCfg> prs{in, 1, 1024};
+
+  ASSERT_EQ(prs.schema().size(), 4UL);
+  EXPECT_EQ(prs.schema()[0], nop::csv::ColumnType::Int64);
+  EXPECT_EQ(prs.schema()[1], nop::csv::ColumnType::Double);
+  EXPECT_EQ(prs.schema()[2], nop::csv::ColumnType::Bool);
+  EXPECT_EQ(prs.schema()[3], nop::csv::ColumnType::String);
+
+  int64_t count{};
+  for (const auto& row : prs)
+  {
+    EXPECT_EQ(std::get<int64_t>(row[0]), count * 1000000000LL);
+    EXPECT_EQ(std::get<double>(row[1]), static_cast<double>(count) + 0.25);
+    EXPECT_EQ(std::get<bool>(row[2]), count % 2 == 0);
+    EXPECT_EQ(std::get<std::string>(row[3]), fmt::format("n,{}", count));
+    ++count;
+  }
+  EXPECT_EQ(count, 20000);
+
+  /* A value the sample did not anticipate */
+  std::stringstream unexpected{"1,a\n2,b\n3.5,c\n"};
+  nop::csv::DynamicParser<nop::csv::DefaultCfg> narrow{unexpected, 0, 4};
+  EXPECT_THROW(
+      {
+        for (const auto& row : narrow)
+          static_cast<void>(row);
+      }
+      , nop::err::FormatError);
+
+  /* Rows written back keep the text of the fields */
+  const std::string fileName{"schema_output.csv"};
+  std::stringstream rows{"1,,x\n,2.5,\"y,z\"\n"};
+  nop::csv::DynamicParser<nop::csv::DefaultCfg> written{rows, 0};
+  {
+    nop::csv::Writer<nop::csv::DefaultCfg> out{fileName.c_str()};
+    for (const auto& row : written)
+      out << row;
+  }
+
+  std::ifstream result{fileName};
+  EXPECT_EQ(std::string(std::istreambuf_iterator<char>{result}, std::istreambuf_iterator<char>{}), "1,,x\n,2.5,\"y,z\"\n");
+  std::filesystem::remove(fileName);
+}
+
+struct RecordCfg
+{
+public:
+  static constexpr std::array<nop::csv::FixedField, 3UL> Fields{{{0UL, 6UL}, {6UL, 10UL}, {16UL, 10UL}}};
+  static constexpr size_t RecordSize{27UL};
+  static constexpr char Padding{' '};
+  static constexpr char Terminator{'\n'};
+};
+
+TEST(TEST_FIXED_WIDTH, RECORDS)
+{
+  static_assert(nop::csv::FixedWidthConfig<RecordCfg> == true);
+
+  std::stringstream in{"HEADER                    \n"
+                       "000042  name one2026-10-17\n"
+                       "    -7      two 1999-01-02\n"
+                       "     1          2000-02-29"};
+  nop::csv::FixedWidthParser<RecordCfg, int32_t, std::string, nop::csv::Date> prs{in, 1};
+
+  std::vector<std::tuple<int32_t, std::string, nop::csv::Date>> rows;
+  for (auto&& row : prs)
+    rows.push_back(std::move(row));
+
+  ASSERT_EQ(rows.size(), 3UL);
+  EXPECT_EQ(std::get<0>(rows[0]), 42);
+  EXPECT_EQ(std::get<1>(rows[0]), "name one");
+  EXPECT_EQ(std::get<2>(rows[0]).value, std::chrono::sys_days{std::chrono::year{2026} / 10 / 17});
+  EXPECT_EQ(std::get<0>(rows[1]), -7);
+  EXPECT_EQ(std::get<1>(rows[1]), "two");
+  EXPECT_EQ(std::get<1>(rows[2]), "");
+
+  std::stringstream truncated{"000042  name one2026-10-17\n    -7"};
+  nop::csv::FixedWidthParser<RecordCfg, int32_t, std::string, nop::csv::Date> cut{truncated, 0};
+  EXPECT_THROW(
+      {
+        for (auto&& row : cut)
+          static_cast<void>(row);
+      }
+      , nop::err::FormatError);
+
+  std::stringstream invalid{"0000x2  name one2026-10-17\n"};
+  nop::csv::FixedWidthParser<RecordCfg, int32_t, std::string, nop::csv::Date> wrong{invalid, 0};
+  EXPECT_THROW(
+      {
+        for (auto&& row : wrong)
+          static_cast<void>(row);
+      }
+      , nop::err::FormatError);
+
+  /* A record without its terminator: its fields still parse, but every later record would shift */
+  std::stringstream shifted{"000042  name one2026-10-17\n"
+                            "    -7      two 1999-01-02"
+                            "     1          2000-02-29\n"};
+  nop::csv::FixedWidthParser<RecordCfg, int32_t, std::string, nop::csv::Date> misaligned{shifted, 0};
+  size_t parsed{};
+  try
+  {
+    for (auto&& row : misaligned)
+    {
+      static_cast<void>(row);
+      ++parsed;
+    }
+    FAIL();
+  }
+  catch (const nop::err::FormatError& error)
+  {
+    EXPECT_NE(std::string{error.what()}.find("Record : 1"), std::string::npos);
+  }
+  EXPECT_EQ(parsed, 1UL);
+}
+
+TEST(TEST_FIXED_WIDTH, PARALLEL_CHUNKS)
+{
+  const std::string fileName{"fixed_width.dat"};
+  const std::string outputName{"fixed_width_output.csv"};
+  std::multiset<std::string> expected;
+  {
+    std::ofstream out{fileName};
+
+    for (int32_t i{}; i < 5000; ++i)
+    {
+      out << fmt::format("{:>6}{:<10}2026-10-{:02}\n", i, fmt::format("row{}", i), i % 28 + 1);
+      expected.insert(fmt::format("{},row{},2026-10-{:02}", i, i, i % 28 + 1));
+    }
+  }
+
+  auto chunks{nop::csv::splitRecords({fileName}, 4000UL, RecordCfg::RecordSize)};
+  ASSERT_GT(chunks.size(), 10UL);
+
+  for (const auto& chunk : chunks)
+    EXPECT_EQ(chunk.begin % RecordCfg::RecordSize, 0UL);
+
+  std::mutex lock;
+  nop::csv::ThreadPool pool{3UL};
+  int32_t file{::open(outputName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+  size_t records{nop::csv::ingestFixedWidth<RecordCfg, nop::csv::DefaultCfg, int32_t, std::string, nop::csv::Date>(chunks, 0, pool, file, lock)};
+  ::close(file);
+  EXPECT_EQ(records, 5000UL);
+
+  std::multiset<std::string> written;
+  std::ifstream in{outputName};
+  for (std::string line; std::getline(in, line);)
+    written.insert(line);
+  EXPECT_EQ(written, expected);
+
+  std::filesystem::remove(fileName);
+  std::filesystem::remove(outputName);
+}
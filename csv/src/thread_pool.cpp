@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <utility>
+#include "thread_pool.hpp"
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    ThreadPool::ThreadPool(size_t threads)
+      : m_queued{0UL}
+      , m_pending{0UL}
+      , m_next{0UL}
+      , m_stop{false}
+    {
+      threads = std::max(threads, 1UL);
+
+      for (size_t i{}; i < threads; ++i)
+        m_queues.push_back(std::make_unique<Queue>());
+
+      for (size_t i{}; i < threads; ++i)
+        m_threads.emplace_back(&ThreadPool::run, this, i);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+      {
+        std::lock_guard<std::mutex> guard{m_lock};
+        m_stop = true;
+      }
+
+      m_wake.notify_all();
+
+      for (auto& thread : m_threads)
+        thread.join();
+    }
+
+    size_t ThreadPool::size() const noexcept
+    {
+      return m_threads.size();
+    }
+
+    void ThreadPool::submit(Task task)
+    {
+      size_t index;
+
+      {
+        std::lock_guard<std::mutex> guard{m_lock};
+        index = m_next++ % m_queues.size();
+        ++m_queued;
+        ++m_pending;
+      }
+
+      {
+        std::lock_guard<std::mutex> guard{m_queues[index]->lock};
+        m_queues[index]->tasks.push_back(std::move(task));
+      }
+
+      m_wake.notify_one();
+    }
+
+    bool ThreadPool::tryPop(size_t self, Task& task)
+    {
+      for (size_t i{}; i < m_queues.size(); ++i)
+      {
+        Queue& queue{*m_queues[(self + i) % m_queues.size()]};
+        std::lock_guard<std::mutex> guard{queue.lock};
+
+        if (queue.tasks.empty() == true)
+          continue;
+
+        /* Own and stolen work alike is taken oldest first: tasks submitted largest first stay so */
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+      }
+
+      return false;
+    }
+
+    void ThreadPool::run(size_t self)
+    {
+      for (;;)
+      {
+        Task task;
+
+        if (tryPop(self, task) == true)
+        {
+          {
+            std::lock_guard<std::mutex> guard{m_lock};
+            --m_queued;
+          }
+
+          try
+          {
+            task();
+          }
+          catch (...)
+          {
+            std::lock_guard<std::mutex> guard{m_lock};
+
+            if (m_error == nullptr)
+              m_error = std::current_exception();
+          }
+
+          std::lock_guard<std::mutex> guard{m_lock};
+
+          if (--m_pending == 0UL)
+            m_idle.notify_all();
+
+          continue;
+        }
+
+        std::unique_lock<std::mutex> lock{m_lock};
+        m_wake.wait(lock, [this] { return m_stop == true || m_queued > 0UL; });
+
+        if (m_stop == true && m_queued == 0UL)
+          return;
+      }
+    }
+
+    void ThreadPool::wait()
+    {
+      std::unique_lock<std::mutex> lock{m_lock};
+      m_idle.wait(lock, [this] { return m_pending == 0UL; });
+
+      if (m_error != nullptr)
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+    }
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
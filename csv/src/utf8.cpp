@@ -0,0 +1,240 @@
+#include <cstdint>
+#include <cstring>
+#include "utf8.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <immintrin.h>
+  #define NOP_CSV_UTF8_AVX2 1
+#endif
+
+namespace nop /* Begin namespace nop */
+{
+
+  namespace csv /* Begin namespace csv */
+  {
+
+    [[nodiscard]] static size_t validateScalar(std::string_view text) noexcept
+    {
+      const auto* data{reinterpret_cast<const uint8_t*>(text.data())};
+      size_t size{text.size()};
+      size_t position{};
+
+      while (position < size)
+      {
+        /* Eight ASCII bytes at a time */
+        if (position + 8UL <= size)
+        {
+          uint64_t word;
+          std::memcpy(&word, data + position, sizeof(word));
+
+          if ((word & 0x8080808080808080UL) == 0UL)
+          {
+            position += 8UL;
+            continue;
+          }
+        }
+
+        uint8_t lead{data[position]};
+
+        if (lead < 0x80U)
+        {
+          ++position;
+          continue;
+        }
+
+        size_t length;
+        uint8_t lower{0x80U};
+        uint8_t upper{0xBFU};
+
+        if (lead >= 0xC2U && lead <= 0xDFU)
+          length = 2UL;
+        else if (lead >= 0xE0U && lead <= 0xEFU)
+        {
+          length = 3UL;
+          lower = lead == 0xE0U ? 0xA0U : 0x80U;
+          upper = lead == 0xEDU ? 0x9FU : 0xBFU;
+        }
+        else if (lead >= 0xF0U && lead <= 0xF4U)
+        {
+          length = 4UL;
+          lower = lead == 0xF0U ? 0x90U : 0x80U;
+          upper = lead == 0xF4U ? 0x8FU : 0xBFU;
+        }
+        else
+          return position;
+
+        if (position + length > size || data[position + 1UL] < lower || data[position + 1UL] > upper)
+          return position;
+
+        for (size_t i{2UL}; i < length; ++i)
+          if ((data[position + i] & 0xC0U) != 0x80U)
+            return position;
+
+        position += length;
+      }
+
+      return std::string_view::npos;
+    }
+
+#ifdef NOP_CSV_UTF8_AVX2
+
+    /* Error classes of a pair of adjacent bytes, see "Validating UTF-8 In Less Than One Instruction Per Byte" */
+    static constexpr uint8_t TooShort{1U << 0U};
+    static constexpr uint8_t TooLong{1U << 1U};
+    static constexpr uint8_t Overlong3{1U << 2U};
+    static constexpr uint8_t TooLarge{1U << 3U};
+    static constexpr uint8_t Surrogate{1U << 4U};
+    static constexpr uint8_t Overlong2{1U << 5U};
+    static constexpr uint8_t TooLarge1000{1U << 6U};
+    static constexpr uint8_t Overlong4{1U << 6U};
+    static constexpr uint8_t TwoContinuations{1U << 7U};
+    static constexpr uint8_t Carry{TooShort | TooLong | TwoContinuations};
+
+    __attribute__((target("avx2")))
+    [[nodiscard]] static inline __m256i lookup(__m256i nibbles,
+                                               uint8_t v0, uint8_t v1, uint8_t v2, uint8_t v3,
+                                               uint8_t v4, uint8_t v5, uint8_t v6, uint8_t v7,
+                                               uint8_t v8, uint8_t v9, uint8_t v10, uint8_t v11,
+                                               uint8_t v12, uint8_t v13, uint8_t v14, uint8_t v15) noexcept
+    {
+      __m256i table{_mm256_setr_epi8(
+          static_cast<char>(v0), static_cast<char>(v1), static_cast<char>(v2), static_cast<char>(v3),
+          static_cast<char>(v4), static_cast<char>(v5), static_cast<char>(v6), static_cast<char>(v7),
+          static_cast<char>(v8), static_cast<char>(v9), static_cast<char>(v10), static_cast<char>(v11),
+          static_cast<char>(v12), static_cast<char>(v13), static_cast<char>(v14), static_cast<char>(v15),
+          static_cast<char>(v0), static_cast<char>(v1), static_cast<char>(v2), static_cast<char>(v3),
+          static_cast<char>(v4), static_cast<char>(v5), static_cast<char>(v6), static_cast<char>(v7),
+          static_cast<char>(v8), static_cast<char>(v9), static_cast<char>(v10), static_cast<char>(v11),
+          static_cast<char>(v12), static_cast<char>(v13), static_cast<char>(v14), static_cast<char>(v15))};
+
+      return _mm256_shuffle_epi8(table, nibbles);
+    }
+
+    /* Bytes of input shifted right by Count, the gap filled from the end of previous */
+    template<int32_t Count>
+    __attribute__((target("avx2")))
+    [[nodiscard]] static inline __m256i previous(__m256i input, __m256i previous) noexcept
+    {
+      return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - Count);
+    }
+
+    __attribute__((target("avx2")))
+    [[nodiscard]] static inline __m256i checkBlock(__m256i input, __m256i last) noexcept
+    {
+      const __m256i low{_mm256_set1_epi8(0x0F)};
+      __m256i previous1{previous<1>(input, last)};
+
+      __m256i byte1High{lookup(_mm256_and_si256(_mm256_srli_epi16(previous1, 4), low),
+          TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+          TwoContinuations, TwoContinuations, TwoContinuations, TwoContinuations,
+          TooShort | Overlong2,
+          TooShort,
+          TooShort | Overlong3 | Surrogate,
+          TooShort | TooLarge | TooLarge1000 | Overlong4)};
+
+      __m256i byte1Low{lookup(_mm256_and_si256(previous1, low),
+          Carry | Overlong3 | Overlong2 | Overlong4,
+          Carry | Overlong2,
+          Carry,
+          Carry,
+          Carry | TooLarge,
+          Carry | TooLarge | TooLarge1000,
+          Carry | TooLarge | TooLarge1000,
+          Carry | TooLarge | TooLarge1000,
+          Carry | TooLarge | TooLarge1000,
+          Carry | TooLarge | TooLarge1000,
+          Carry | TooLarge | TooLarge1000,
+          Carry | TooLarge | TooLarge1000,
+          Carry | TooLarge | TooLarge1000,
+          Carry | TooLarge | TooLarge1000 | Surrogate,
+          Carry | TooLarge | TooLarge1000,
+          Carry | TooLarge | TooLarge1000)};
+
+      __m256i byte2High{lookup(_mm256_and_si256(_mm256_srli_epi16(input, 4), low),
+          TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+          TooLong | Overlong2 | TwoContinuations | Overlong3 | TooLarge1000 | Overlong4,
+          TooLong | Overlong2 | TwoContinuations | Overlong3 | TooLarge,
+          TooLong | Overlong2 | TwoContinuations | Surrogate | TooLarge,
+          TooLong | Overlong2 | TwoContinuations | Surrogate | TooLarge,
+          TooShort, TooShort, TooShort, TooShort)};
+
+      __m256i special{_mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High)};
+
+      /* Only 111_____ (third byte) and 1111____ (fourth byte) leads reach 0x80 */
+      __m256i third{_mm256_subs_epu8(previous<2>(input, last), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)))};
+      __m256i fourth{_mm256_subs_epu8(previous<3>(input, last), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)))};
+      __m256i continuation{_mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)))};
+
+      return _mm256_xor_si256(continuation, special);
+    }
+
+    /* Non-zero when the block ends inside a multibyte sequence */
+    __attribute__((target("avx2")))
+    [[nodiscard]] static inline __m256i incomplete(__m256i input) noexcept
+    {
+      const __m256i limit{_mm256_setr_epi8(
+          -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+          -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+          static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1))};
+
+      return _mm256_subs_epu8(input, limit);
+    }
+
+    /* All-ASCII blocks skip the classification, they can only complete an error left pending */
+    __attribute__((target("avx2")))
+    static inline void step(__m256i input, __m256i& error, __m256i& last, __m256i& pending) noexcept
+    {
+      if (_mm256_movemask_epi8(input) == 0)
+        error = _mm256_or_si256(error, pending);
+      else
+      {
+        error = _mm256_or_si256(error, checkBlock(input, last));
+        pending = incomplete(input);
+      }
+
+      last = input;
+    }
+
+    __attribute__((target("avx2")))
+    [[nodiscard]] static bool validAvx2(std::string_view text) noexcept
+    {
+      constexpr size_t BlockSize{32UL};
+
+      __m256i error{_mm256_setzero_si256()};
+      __m256i last{_mm256_setzero_si256()};
+      __m256i pending{_mm256_setzero_si256()};
+      size_t position{};
+
+      for (; position + BlockSize <= text.size(); position += BlockSize)
+        step(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text.data() + position)), error, last, pending);
+
+      /* Zero padding is ASCII, so a sequence cut by the end still reports as incomplete */
+      if (position < text.size())
+      {
+        alignas(32) char tail[BlockSize]{};
+        std::memcpy(tail, text.data() + position, text.size() - position);
+        step(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)), error, last, pending);
+      }
+
+      error = _mm256_or_si256(error, pending);
+      return _mm256_testz_si256(error, error) == 1;
+    }
+
+#endif
+
+    size_t validateUtf8(std::string_view text) noexcept
+    {
+#ifdef NOP_CSV_UTF8_AVX2
+      static const bool avx2{__builtin_cpu_supports("avx2") != 0};
+
+      /* The vector pass only answers yes or no, the scalar one locates the error */
+      if (avx2 == true && text.size() >= 32UL)
+        return validAvx2(text) == true ? std::string_view::npos : validateScalar(text);
+#endif
+
+      return validateScalar(text);
+    }
+
+  } /* End namespace csv */
+
+} /* End namespace nop */
@@ -0,0 +1,83 @@
+#ifndef __NOP_MATRIX_KERNELS_H__
+#define __NOP_MATRIX_KERNELS_H__ 1
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "matrix.h"
+
+/*
+ * Kernels of one instruction set. The GEMM loops, packing and threading are shared
+ * (gemm.c): a backend brings its register tile (mr x nr), cache blocks (mc, kc, nc;
+ * multiples of the tile) and the micro-kernel, which computes an mr x nr corner of
+ * the tile from packed panels. Streaming kernels work on contiguous runs of floats,
+ * transpose_block on a block (rows x columns of src) small enough to stay in cache.
+ */
+typedef struct matrix_kernels
+{
+  const char* name;
+  size_t mr;
+  size_t nr;
+  size_t mc;
+  size_t kc;
+  size_t nc;
+  void (*micro_kernel)(size_t kc,
+                       const f32* __restrict__ a,
+                       const f32* __restrict__ b,
+                       f32* __restrict__ c,
+                       size_t ldc,
+                       size_t mr,
+                       size_t nr,
+                       bool accumulate);
+  void (*scale)(f32* matrix, size_t count, f32 value);
+  void (*add)(const f32* lhs, const f32* rhs, f32* res, size_t count);
+  void (*copy)(const f32* __restrict__ src, f32* __restrict__ dst, size_t count);
+  void (*axpy)(f32 alpha, const f32* __restrict__ x, f32* __restrict__ y, size_t count);
+  void (*transpose_block)(const f32* __restrict__ src,
+                          size_t lds,
+                          f32* __restrict__ dst,
+                          size_t ldd,
+                          size_t rows,
+                          size_t columns);
+  f32 (*abs_sum)(const f32* row, size_t count);
+  void (*abs_accumulate)(const f32* row, f32* __restrict__ sums, size_t count);
+} matrix_kernels;
+
+extern const matrix_kernels scalar_kernels;
+extern const matrix_kernels avx2_kernels;
+extern const matrix_kernels avx512_kernels;
+
+/* Backend bound at load time from CPUID */
+const matrix_kernels* active_kernels(void);
+
+/*
+ * Options of gemm: add to C instead of overwriting it, read A (stored k x m) or
+ * B (stored n x k) transposed, compute only the tiles that reach the upper
+ * triangle of C (the rest of C is left as is or partially written), negate the
+ * product (B is negated while it is packed, so with GEMM_ACCUMULATE C -= AB).
+ */
+typedef enum GEMM_FLAGS
+{
+  GEMM_DEFAULT = 0,
+  GEMM_ACCUMULATE = 1,
+  GEMM_TRANS_A = 2,
+  GEMM_TRANS_B = 4,
+  GEMM_UPPER = 8,
+  GEMM_SUBTRACT = 16
+} GEMM_FLAGS;
+
+/* C (m x n) = ±op(A) op(B), or C ±= op(A) op(B) */
+void gemm(size_t m,
+          size_t n,
+          size_t k,
+          const f32* A,
+          size_t lda,
+          const f32* B,
+          size_t ldb,
+          f32* __restrict__ C,
+          size_t ldc,
+          GEMM_FLAGS flags);
+
+/* C (n x n) = A^T A for A stored k x n, both triangles written */
+void syrk(size_t n, size_t k, const f32* A, size_t lda, f32* __restrict__ C, size_t ldc);
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef __NOP_MATRIX_H__
 #define __NOP_MATRIX_H__ 1
 
+#include <stddef.h>
+#include <stdbool.h>
+
 typedef float f32;
 
 typedef enum NORM_DIRECTION
@@ -9,12 +12,52 @@ typedef enum NORM_DIRECTION
   COLUMN = 2
 } NORM_DIRECTION;
 
+/*
+ * Evaluation of the truncated Neumann series I + R + ... + R^(M-1) in inverse:
+ * term by term (M GEMMs) or by repeated squaring (about 2 log2(M) GEMMs).
+ */
+typedef enum INVERSE_MODE
+{
+  NEUMANN_SERIES = 1,
+  NEUMANN_DOUBLING = 2
+} INVERSE_MODE;
+
+/* Triangle of a square matrix used by the triangular solves */
+typedef enum TRIANGLE
+{
+  LOWER_UNIT = 1,
+  UPPER = 2
+} TRIANGLE;
+
+/* Outcome of an iterative inverse: updates applied and final ||I - A X|| (row norm) */
+typedef struct inverse_status
+{
+  size_t iterations;
+  f32 residual;
+} inverse_status;
+
 f32* create_matrix(size_t);
 f32* create_identity(size_t);
 void delete_matrix(f32*);
 
+void create_team(size_t, bool);
+void delete_team(void);
+
 f32* transpose(f32*, size_t);
 f32* inverse(f32*, size_t, size_t);
+f32* inverse_mode(INVERSE_MODE, f32*, size_t, size_t);
+f32* inverse_newton(f32*, size_t, size_t, f32, inverse_status*);
+
+/*
+ * Buffers of the Neumann inverse for one matrix size. Create it once and pass it
+ * to inverse_into to invert many same-sized matrices without allocating; inv_A is
+ * a matrix of that size (e.g. from create_matrix).
+ */
+typedef struct inverse_workspace inverse_workspace;
+
+inverse_workspace* create_workspace(size_t);
+void delete_workspace(inverse_workspace*);
+void inverse_into(inverse_workspace*, INVERSE_MODE, const f32*, size_t, f32* __restrict__);
 void fill_matrix(f32*, size_t);
 void mul_matrix(const f32*, const f32*, f32* __restrict__, size_t);
 void muls_matrix(f32*, size_t, f32);
@@ -23,4 +66,38 @@ void copy_matrix(const f32* __restrict__, f32* __restrict__, size_t);
 
 f32 compute_norm(NORM_DIRECTION, const f32*, size_t);
 
+/*
+ * Rectangular matrices: row-major rows x columns with an explicit leading dimension
+ * (distance between rows, ld >= columns). create_matrix_mn pads rows tightly to
+ * leading_dimension(columns), the next multiple of 16 floats; any ld works with the
+ * other functions, e.g. to address a block of a larger matrix. The square API above
+ * keeps its own padding and is a special case of this one.
+ */
+size_t leading_dimension(size_t);
+f32* create_matrix_mn(size_t, size_t);
+void fill_matrix_mn(f32*, size_t, size_t, size_t);
+void transpose_mn(const f32* __restrict__, size_t, size_t, size_t, f32* __restrict__, size_t);
+void transpose_inplace(f32*, size_t, size_t);
+void mul_matrix_mn(size_t, size_t, size_t, const f32*, size_t, const f32*, size_t, f32* __restrict__, size_t);
+void muls_matrix_mn(f32*, size_t, size_t, size_t, f32);
+void sum_matrix_mn(const f32*, size_t, const f32*, size_t, f32*, size_t, size_t, size_t);
+void copy_matrix_mn(const f32* __restrict__, size_t, f32* __restrict__, size_t, size_t, size_t);
+
+f32 compute_norm_mn(NORM_DIRECTION, const f32*, size_t, size_t, size_t);
+
+/*
+ * Direct solves (row-major, explicit leading dimensions). lu_factor overwrites the
+ * n x n matrix A with L (unit lower, below the diagonal) and U such that P A = L U,
+ * pivots[i] being the row swapped with row i at step i; it returns false if A is
+ * singular to working precision. lu_solve overwrites the n x nrhs matrix B with
+ * A^-1 B from that factorization, trsm/trsv solve T X = B / T x = b in place.
+ */
+bool lu_factor(f32*, size_t, size_t, size_t*);
+void lu_solve(const f32*, size_t, size_t, const size_t*, f32*, size_t, size_t);
+void trsm(TRIANGLE, const f32*, size_t, size_t, f32*, size_t, size_t);
+void trsv(TRIANGLE, const f32*, size_t, size_t, f32*);
+
+/* Name of the SIMD backend selected at load time: "scalar", "avx2" or "avx512" */
+const char* matrix_backend(void);
+
 #endif
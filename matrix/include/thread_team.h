@@ -0,0 +1,12 @@
+#ifndef __NOP_THREAD_TEAM_H__
+#define __NOP_THREAD_TEAM_H__ 1
+
+#include <stddef.h>
+
+/* Runs items [begin, end) of a parallel loop on the team member with index thread */
+typedef void (*team_task)(void* context, size_t begin, size_t end, size_t thread);
+
+size_t team_size(void);
+void team_parallel_for(size_t count, size_t grain, team_task task, void* context);
+
+#endif
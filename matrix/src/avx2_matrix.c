@@ -0,0 +1,245 @@
+#pragma GCC target("avx2,fma")
+
+#define __AVX_ALIGN__ (32UL)
+#define __AVX_STEP__ (8UL)
+
+/* GEMM register tile (rows x columns of C) and cache blocks, MC and NC are multiples of MR and NR */
+#define __GEMM_MR__ (6UL)
+#define __GEMM_NR__ (16UL)
+#define __GEMM_MC__ (120UL)
+#define __GEMM_KC__ (256UL)
+#define __GEMM_NC__ (3072UL)
+
+#include <stddef.h>
+#include <immintrin.h>
+#include "kernels.h"
+
+/*
+ * C (mr x nr corner of the tile) = (or +=) packed A micro-panel * packed B micro-panel.
+ * The 6 x 16 tile lives in 12 ymm registers, each k step issues 2 loads of B,
+ * 6 broadcasts of A and 12 independent FMAs. A partial tile goes through a
+ * local buffer, AVX2 has no cheap masked stores of arbitrary width.
+ */
+static void micro_kernel(size_t kc,
+                         const f32* __restrict__ a,
+                         const f32* __restrict__ b,
+                         f32* __restrict__ c,
+                         size_t ldc,
+                         size_t mr,
+                         size_t nr,
+                         bool accumulate)
+{
+  __m256 acc[__GEMM_MR__][2];
+
+#pragma GCC unroll 6
+  for (size_t r = 0; r != __GEMM_MR__; ++r)
+  {
+    acc[r][0] = _mm256_setzero_ps();
+    acc[r][1] = _mm256_setzero_ps();
+  }
+
+  for (size_t p = 0; p != kc; ++p)
+  {
+    __m256 b_lo = _mm256_load_ps(b);
+    __m256 b_hi = _mm256_load_ps(b + __AVX_STEP__);
+
+#pragma GCC unroll 6
+    for (size_t r = 0; r != __GEMM_MR__; ++r)
+    {
+      __m256 a_r = _mm256_broadcast_ss(a + r);
+      acc[r][0] = _mm256_fmadd_ps(a_r, b_lo, acc[r][0]);
+      acc[r][1] = _mm256_fmadd_ps(a_r, b_hi, acc[r][1]);
+    }
+
+    a += __GEMM_MR__;
+    b += __GEMM_NR__;
+  }
+
+  if (nr == __GEMM_NR__)
+  {
+#pragma GCC unroll 6
+    for (size_t r = 0; r != __GEMM_MR__; ++r)
+    {
+      if (r == mr)
+        break;
+
+      f32* row = c + r * ldc;
+
+      if (accumulate == true)
+      {
+        acc[r][0] = _mm256_add_ps(acc[r][0], _mm256_loadu_ps(row));
+        acc[r][1] = _mm256_add_ps(acc[r][1], _mm256_loadu_ps(row + __AVX_STEP__));
+      }
+
+      _mm256_storeu_ps(row, acc[r][0]);
+      _mm256_storeu_ps(row + __AVX_STEP__, acc[r][1]);
+    }
+
+    return;
+  }
+
+  f32 tile[__GEMM_MR__][__GEMM_NR__];
+
+  for (size_t r = 0; r != mr; ++r)
+  {
+    _mm256_storeu_ps(tile[r], acc[r][0]);
+    _mm256_storeu_ps(tile[r] + __AVX_STEP__, acc[r][1]);
+
+    for (size_t j = 0; j != nr; ++j)
+      c[r * ldc + j] = accumulate == true ? c[r * ldc + j] + tile[r][j] : tile[r][j];
+  }
+}
+
+static void scale(f32* matrix, size_t count, f32 value)
+{
+  __m256 factor = _mm256_set1_ps(value);
+  size_t i = 0;
+
+  for (; i + __AVX_STEP__ <= count; i += __AVX_STEP__)
+    _mm256_storeu_ps(matrix + i, _mm256_mul_ps(_mm256_loadu_ps(matrix + i), factor));
+
+  for (; i != count; ++i)
+    matrix[i] *= value;
+}
+
+static void add(const f32* lhs, const f32* rhs, f32* res, size_t count)
+{
+  size_t i = 0;
+
+  for (; i + __AVX_STEP__ <= count; i += __AVX_STEP__)
+    _mm256_storeu_ps(res + i,
+                     _mm256_add_ps(_mm256_loadu_ps(lhs + i),
+                                   _mm256_loadu_ps(rhs + i)));
+
+  for (; i != count; ++i)
+    res[i] = lhs[i] + rhs[i];
+}
+
+static void copy(const f32* __restrict__ src, f32* __restrict__ dst, size_t count)
+{
+  size_t i = 0;
+
+  for (; i + __AVX_STEP__ <= count; i += __AVX_STEP__)
+    _mm256_storeu_ps(dst + i, _mm256_loadu_ps(src + i));
+
+  for (; i != count; ++i)
+    dst[i] = src[i];
+}
+
+static void axpy(f32 alpha, const f32* __restrict__ x, f32* __restrict__ y, size_t count)
+{
+  __m256 factor = _mm256_set1_ps(alpha);
+  size_t i = 0;
+
+  for (; i + __AVX_STEP__ <= count; i += __AVX_STEP__)
+    _mm256_storeu_ps(y + i, _mm256_fmadd_ps(factor, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+
+  for (; i != count; ++i)
+    y[i] += alpha * x[i];
+}
+
+/* Transposes a full 8 x 8 tile in registers: 32-bit and 64-bit unpacks, then 128-bit lane swaps */
+static void transpose_tile(const f32* __restrict__ src, size_t lds, f32* __restrict__ dst, size_t ldd)
+{
+  __m256 r[8];
+  __m256 t[8];
+
+#pragma GCC unroll 8
+  for (size_t i = 0; i != 8; ++i)
+    r[i] = _mm256_loadu_ps(src + i * lds);
+
+#pragma GCC unroll 4
+  for (size_t i = 0; i != 8; i += 2)
+  {
+    t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+    t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+  }
+
+#pragma GCC unroll 2
+  for (size_t i = 0; i != 8; i += 4)
+  {
+    r[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+    r[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+    r[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+    r[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+  }
+
+#pragma GCC unroll 4
+  for (size_t i = 0; i != 4; ++i)
+  {
+    _mm256_storeu_ps(dst + i * ldd, _mm256_permute2f128_ps(r[i], r[i + 4], 0x20));
+    _mm256_storeu_ps(dst + (i + 4) * ldd, _mm256_permute2f128_ps(r[i], r[i + 4], 0x31));
+  }
+}
+
+/* Full 8 x 8 tiles go through registers, the ragged edges element by element */
+static void transpose_block(const f32* __restrict__ src,
+                            size_t lds,
+                            f32* __restrict__ dst,
+                            size_t ldd,
+                            size_t rows,
+                            size_t columns)
+{
+  size_t full_rows = rows & ~(__AVX_STEP__ - 1);
+  size_t full_columns = columns & ~(__AVX_STEP__ - 1);
+
+  for (size_t i = 0; i != full_rows; i += __AVX_STEP__)
+    for (size_t j = 0; j != full_columns; j += __AVX_STEP__)
+      transpose_tile(src + i * lds + j, lds, dst + j * ldd + i, ldd);
+
+  for (size_t i = 0; i != rows; ++i)
+    for (size_t j = i < full_rows ? full_columns : 0; j != columns; ++j)
+      dst[j * ldd + i] = src[i * lds + j];
+}
+
+static inline __m256 abs_ps(__m256 value)
+{
+  return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value);
+}
+
+static f32 abs_sum(const f32* row, size_t count)
+{
+  __m256 sum = _mm256_setzero_ps();
+  size_t j = 0;
+
+  for (; j + __AVX_STEP__ <= count; j += __AVX_STEP__)
+    sum = _mm256_add_ps(sum, abs_ps(_mm256_loadu_ps(row + j)));
+
+  __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+  half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+  half = _mm_add_ss(half, _mm_movehdup_ps(half));
+  f32 total = _mm_cvtss_f32(half);
+
+  for (; j != count; ++j)
+    total += row[j] < 0.0f ? -row[j] : row[j];
+
+  return total;
+}
+
+static void abs_accumulate(const f32* row, f32* __restrict__ sums, size_t count)
+{
+  size_t j = 0;
+
+  for (; j + __AVX_STEP__ <= count; j += __AVX_STEP__)
+    _mm256_storeu_ps(sums + j, _mm256_add_ps(_mm256_loadu_ps(sums + j), abs_ps(_mm256_loadu_ps(row + j))));
+
+  for (; j != count; ++j)
+    sums[j] += row[j] < 0.0f ? -row[j] : row[j];
+}
+
+const matrix_kernels avx2_kernels = {
+  .name = "avx2",
+  .mr = __GEMM_MR__,
+  .nr = __GEMM_NR__,
+  .mc = __GEMM_MC__,
+  .kc = __GEMM_KC__,
+  .nc = __GEMM_NC__,
+  .micro_kernel = micro_kernel,
+  .scale = scale,
+  .add = add,
+  .copy = copy,
+  .axpy = axpy,
+  .transpose_block = transpose_block,
+  .abs_sum = abs_sum,
+  .abs_accumulate = abs_accumulate
+};
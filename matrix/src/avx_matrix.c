@@ -1,261 +1,248 @@
+#pragma GCC target("avx512f,fma")
+
 #define __AVX_ALIGN__ (64UL)
 #define __AVX_STEP__ (16UL)
 
-#define __ERROR__ "\033[1;35m[ERROR]\033[0m"
-#define __RESULT__ "\033[1;35m[RESULT]\033[0m"
-
-#define compute_aligned_size(size) ((size) + (__AVX_ALIGN__ - ((size) & 63)))
+/* GEMM register tile (rows x columns of C) and cache blocks, MC and NC are multiples of MR and NR */
+#define __GEMM_MR__ (14UL)
+#define __GEMM_NR__ (32UL)
+#define __GEMM_MC__ (112UL)
+#define __GEMM_KC__ (384UL)
+#define __GEMM_NC__ (3072UL)
 
-#include <stdio.h>
-#include <stdlib.h>
 #include <stddef.h>
-#include <float.h>
-#include <math.h>
 #include <immintrin.h>
-#include "matrix.h"
+#include "kernels.h"
 
-[[nodiscard]] f32* create_matrix(size_t size)
+static inline __mmask16 tail_mask(size_t count)
 {
-  size_t aligned_size = compute_aligned_size(size);
-  aligned_size *= aligned_size;
-  f32* matrix = aligned_alloc(__AVX_ALIGN__, aligned_size << 2);
+  return count >= __AVX_STEP__ ? 0xFFFF : (__mmask16)((1U << count) - 1U);
+}
 
-  if (matrix == NULL)
+/*
+ * C (mr x nr corner of the tile) = (or +=) packed A micro-panel * packed B micro-panel.
+ * The 14 x 32 tile lives in 28 zmm registers, each k step issues 2 loads of B,
+ * 14 broadcasts of A and 28 independent FMAs.
+ */
+static void micro_kernel(size_t kc,
+                         const f32* __restrict__ a,
+                         const f32* __restrict__ b,
+                         f32* __restrict__ c,
+                         size_t ldc,
+                         size_t mr,
+                         size_t nr,
+                         bool accumulate)
+{
+  b = __builtin_assume_aligned(b, __AVX_ALIGN__);
+  __mmask16 mask_lo = tail_mask(nr);
+  __mmask16 mask_hi = nr <= __AVX_STEP__ ? 0 : tail_mask(nr - __AVX_STEP__);
+  __m512 acc[__GEMM_MR__][2];
+
+#pragma GCC unroll 14
+  for (size_t r = 0; r != __GEMM_MR__; ++r)
   {
-    fprintf(stderr,
-            "%s Cannot allocate memory\n"
-            "%s Terminating process...\n",
-            __ERROR__,
-            __RESULT__);
-    exit(EXIT_FAILURE);
+    acc[r][0] = _mm512_setzero_ps();
+    acc[r][1] = _mm512_setzero_ps();
   }
 
-  f32* end = matrix + aligned_size;
+  for (size_t p = 0; p != kc; ++p)
+  {
+    __m512 b_lo = _mm512_load_ps(b);
+    __m512 b_hi = _mm512_load_ps(b + __AVX_STEP__);
 
-  for (register f32* begin = matrix; begin < end; begin += __AVX_STEP__)
-    _mm512_store_ps(begin, _mm512_setzero_ps());
+#pragma GCC unroll 14
+    for (size_t r = 0; r != __GEMM_MR__; ++r)
+    {
+      __m512 a_r = _mm512_set1_ps(a[r]);
+      acc[r][0] = _mm512_fmadd_ps(a_r, b_lo, acc[r][0]);
+      acc[r][1] = _mm512_fmadd_ps(a_r, b_hi, acc[r][1]);
+    }
 
-  return matrix;
-}
+    a += __GEMM_MR__;
+    b += __GEMM_NR__;
+  }
 
-[[nodiscard]] f32* create_identity(size_t size)
-{
-  f32* matrix = __builtin_assume_aligned(create_matrix(size), __AVX_ALIGN__);
-  size_t aligned_size = compute_aligned_size(size);
+#pragma GCC unroll 14
+  for (size_t r = 0; r != __GEMM_MR__; ++r)
+  {
+    if (r == mr)
+      break;
 
-  for (size_t i = 0; i != size; ++i)
-    matrix[i * aligned_size + i] = 1.0f;
+    f32* row = c + r * ldc;
 
-  return matrix;
+    if (accumulate == true)
+    {
+      acc[r][0] = _mm512_add_ps(acc[r][0], _mm512_maskz_loadu_ps(mask_lo, row));
+      acc[r][1] = _mm512_add_ps(acc[r][1], _mm512_maskz_loadu_ps(mask_hi, row + __AVX_STEP__));
+    }
+
+    _mm512_mask_storeu_ps(row, mask_lo, acc[r][0]);
+    _mm512_mask_storeu_ps(row + __AVX_STEP__, mask_hi, acc[r][1]);
+  }
 }
 
-[[nodiscard]] f32* transpose(f32* matrix, size_t size)
+static void scale(f32* matrix, size_t count, f32 value)
 {
-  f32* t_matrix = __builtin_assume_aligned(create_matrix(size), __AVX_ALIGN__);
-  size_t aligned_size = compute_aligned_size(size);
+  __m512 factor = _mm512_set1_ps(value);
+  size_t i = 0;
 
-  for (size_t i = 0; i != size; ++i)
-    for (size_t j = 0; j != size; ++j)
-      t_matrix[j * aligned_size + i] = matrix[i * aligned_size + j];
+  for (; i + __AVX_STEP__ <= count; i += __AVX_STEP__)
+    _mm512_storeu_ps(matrix + i, _mm512_mul_ps(_mm512_loadu_ps(matrix + i), factor));
 
-  return t_matrix;
+  _mm512_mask_storeu_ps(matrix + i, tail_mask(count - i), _mm512_mul_ps(_mm512_maskz_loadu_ps(tail_mask(count - i), matrix + i), factor));
 }
 
-[[nodiscard]] static f32* create_B(f32* matrix, size_t size)
+static void add(const f32* lhs, const f32* rhs, f32* res, size_t count)
 {
-  f32* B = __builtin_assume_aligned(transpose(matrix, size), __AVX_ALIGN__);
-  f32 scalar = 1 / (compute_norm(ROW, matrix, size) *
-                    compute_norm(ROW, B, size));
-  muls_matrix(B, size, scalar);
+  size_t i = 0;
 
-  return B;
+  for (; i + __AVX_STEP__ <= count; i += __AVX_STEP__)
+    _mm512_storeu_ps(res + i,
+                     _mm512_add_ps(_mm512_loadu_ps(lhs + i),
+                                   _mm512_loadu_ps(rhs + i)));
+
+  __mmask16 mask = tail_mask(count - i);
+  _mm512_mask_storeu_ps(res + i, mask, _mm512_add_ps(_mm512_maskz_loadu_ps(mask, lhs + i), _mm512_maskz_loadu_ps(mask, rhs + i)));
 }
 
-[[nodiscard]] static f32* create_R(f32* B, f32* A, size_t size)
+static void copy(const f32* __restrict__ src, f32* __restrict__ dst, size_t count)
 {
-  f32* R = __builtin_assume_aligned(create_matrix(size), __AVX_ALIGN__);
-  size_t aligned_size = compute_aligned_size(size);
+  size_t i = 0;
 
-  mul_matrix(B, A, R, size);
-  muls_matrix(R, size, -1.0f);
-  
-  for (size_t i = 0; i != size; ++i)
-    R[i * aligned_size + i] += 1.0f;
+  for (; i + __AVX_STEP__ <= count; i += __AVX_STEP__)
+    _mm512_storeu_ps(dst + i, _mm512_loadu_ps(src + i));
 
-  return R;
+  _mm512_mask_storeu_ps(dst + i, tail_mask(count - i), _mm512_maskz_loadu_ps(tail_mask(count - i), src + i));
 }
 
-[[nodiscard]] f32* inverse(f32* A, size_t N, size_t M)
+static void axpy(f32 alpha, const f32* __restrict__ x, f32* __restrict__ y, size_t count)
 {
-  if (M == 0)
-    return create_matrix(N);
-
-  f32* B = __builtin_assume_aligned(create_B(A, N), __AVX_ALIGN__);
-  f32* R = __builtin_assume_aligned(create_R(B, A, N), __AVX_ALIGN__);
-  f32* R_curr = __builtin_assume_aligned(create_matrix(N), __AVX_ALIGN__);
-  copy_matrix(R, R_curr, N);
-  f32* R_prev = __builtin_assume_aligned(create_identity(N), __AVX_ALIGN__);
-  f32* accum = __builtin_assume_aligned(create_identity(N), __AVX_ALIGN__);
-
-  for (size_t i = 1; i != M; ++i)
-  {
-    sum_matrix(accum, R_curr, accum, N);
-    copy_matrix(R_curr, R_prev, N);
-    mul_matrix(R_prev, R, R_curr, N);
-  }
+  __m512 factor = _mm512_set1_ps(alpha);
+  size_t i = 0;
 
-  free(R);
-  free(R_curr);
-  free(R_prev);
+  for (; i + __AVX_STEP__ <= count; i += __AVX_STEP__)
+    _mm512_storeu_ps(y + i, _mm512_fmadd_ps(factor, _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)));
 
-  f32* inv_A = __builtin_assume_aligned(create_matrix(N), __AVX_ALIGN__);
-  mul_matrix(accum, B, inv_A, N);
-
-  free(B);
-  free(accum);
-
-  return inv_A;
+  __mmask16 mask = tail_mask(count - i);
+  _mm512_mask_storeu_ps(y + i, mask, _mm512_fmadd_ps(factor, _mm512_maskz_loadu_ps(mask, x + i), _mm512_maskz_loadu_ps(mask, y + i)));
 }
 
-void fill_matrix(f32* matrix, size_t size)
+/*
+ * Transposes a 16 x 16 tile in registers: unpacks of rows in pairs (32-bit, then
+ * 64-bit elements) give 4 x 4 blocks per 128-bit lane, two rounds of lane
+ * shuffles put the lanes in place. Rows past rows are zero, columns past columns
+ * are neither read nor written.
+ */
+static void transpose_tile(const f32* __restrict__ src,
+                           size_t lds,
+                           f32* __restrict__ dst,
+                           size_t ldd,
+                           size_t rows,
+                           size_t columns)
 {
-  matrix = __builtin_assume_aligned(matrix, __AVX_ALIGN__);
-  size_t aligned_size = compute_aligned_size(size);
-  f32* end = matrix + aligned_size * aligned_size;
-
-  for (; matrix < end; matrix += __AVX_STEP__)
-    _mm512_store_ps(matrix, _mm512_set_ps(rand() & 15,
-                                          rand() & 15,
-                                          rand() & 15,
-                                          rand() & 15,
-                                          rand() & 15,
-                                          rand() & 15,
-                                          rand() & 15,
-                                          rand() & 15,
-                                          rand() & 15,
-                                          rand() & 15,
-                                          rand() & 15,
-                                          rand() & 15,
-                                          rand() & 15,
-                                          rand() & 15,
-                                          rand() & 15,
-                                          rand() & 15));
-}
+  __mmask16 load_mask = tail_mask(columns);
+  __mmask16 store_mask = tail_mask(rows);
+  __m512 r[16];
+  __m512 t[16];
 
+#pragma GCC unroll 16
+  for (size_t i = 0; i != 16; ++i)
+    r[i] = i < rows ? _mm512_maskz_loadu_ps(load_mask, src + i * lds) : _mm512_setzero_ps();
 
-void mul_matrix(const f32* lhs,
-                const f32* rhs,
-                f32* __restrict__ res, size_t size)
-{
-  lhs = __builtin_assume_aligned(lhs, __AVX_ALIGN__);
-  rhs = __builtin_assume_aligned(rhs, __AVX_ALIGN__);
-  res = __builtin_assume_aligned(res, __AVX_ALIGN__);
-  size_t aligned_size = compute_aligned_size(size);
-
-  for (size_t i = 0; i != size; ++i)
+#pragma GCC unroll 8
+  for (size_t i = 0; i != 16; i += 2)
   {
-    register f32* tmp_res = res + i * aligned_size;
-
-    for (size_t j = 0; j < size; j += __AVX_STEP__)
-      _mm512_store_ps(tmp_res + j, _mm512_setzero_ps());
-
-    for (size_t j = 0; j != size; ++j)
-    {
-      __m512 tmp_lhs = _mm512_set1_ps(lhs[i * aligned_size + j]);
-      register const f32* tmp_rhs = rhs + j * aligned_size;
-
-      for (register size_t k = 0; k < size; k += __AVX_STEP__)
-        _mm512_store_ps(tmp_res + k,
-                        _mm512_fmadd_ps(tmp_lhs,
-                                        _mm512_load_ps(tmp_rhs + k),
-                                        _mm512_load_ps(tmp_res + k)));
-    }
+    t[i] = _mm512_unpacklo_ps(r[i], r[i + 1]);
+    t[i + 1] = _mm512_unpackhi_ps(r[i], r[i + 1]);
   }
-}
 
-void muls_matrix(f32* matrix, size_t size, f32 value)
-{
-  matrix = __builtin_assume_aligned(matrix, __AVX_ALIGN__);
-  size_t aligned_size = compute_aligned_size(size);
-  f32* end = matrix + aligned_size * aligned_size;
-
-  while (matrix < end)
+#pragma GCC unroll 4
+  for (size_t i = 0; i != 16; i += 4)
   {
-    _mm512_store_ps(matrix,
-                    _mm512_mul_ps(_mm512_load_ps(matrix),
-                                  _mm512_set1_ps(value)));
-    matrix += __AVX_STEP__;
+    r[i] = _mm512_castpd_ps(_mm512_unpacklo_pd(_mm512_castps_pd(t[i]), _mm512_castps_pd(t[i + 2])));
+    r[i + 1] = _mm512_castpd_ps(_mm512_unpackhi_pd(_mm512_castps_pd(t[i]), _mm512_castps_pd(t[i + 2])));
+    r[i + 2] = _mm512_castpd_ps(_mm512_unpacklo_pd(_mm512_castps_pd(t[i + 1]), _mm512_castps_pd(t[i + 3])));
+    r[i + 3] = _mm512_castpd_ps(_mm512_unpackhi_pd(_mm512_castps_pd(t[i + 1]), _mm512_castps_pd(t[i + 3])));
   }
-}
 
-void sum_matrix(f32* lhs, f32* rhs, f32* res, size_t size)
-{
-  lhs = __builtin_assume_aligned(lhs, __AVX_ALIGN__);
-  rhs = __builtin_assume_aligned(rhs, __AVX_ALIGN__);
-  res = __builtin_assume_aligned(res, __AVX_ALIGN__);
-  size_t aligned_size = compute_aligned_size(size);
-  f32* end = lhs + aligned_size * aligned_size;
-
-  while (lhs < end)
+#pragma GCC unroll 4
+  for (size_t i = 0; i != 4; ++i)
   {
-    _mm512_store_ps(res,
-                    _mm512_add_ps(_mm512_load_ps(lhs),
-                                  _mm512_load_ps(rhs)));
-    lhs += __AVX_STEP__;
-    rhs += __AVX_STEP__;
-    res += __AVX_STEP__;
+    t[i] = _mm512_shuffle_f32x4(r[i], r[i + 4], 0x88);
+    t[i + 4] = _mm512_shuffle_f32x4(r[i], r[i + 4], 0xDD);
+    t[i + 8] = _mm512_shuffle_f32x4(r[i + 8], r[i + 12], 0x88);
+    t[i + 12] = _mm512_shuffle_f32x4(r[i + 8], r[i + 12], 0xDD);
   }
-}
 
-void copy_matrix(const f32* __restrict__ src, f32* __restrict__ dst, size_t size)
-{
-  src = __builtin_assume_aligned(src, __AVX_ALIGN__);
-  dst = __builtin_assume_aligned(dst, __AVX_ALIGN__);
-  size_t aligned_size = compute_aligned_size(size);
-  const f32* end = src + aligned_size * aligned_size;
-
-  
-  while (src < end)
+#pragma GCC unroll 4
+  for (size_t i = 0; i != 4; ++i)
   {
-    _mm512_store_ps(dst, _mm512_load_ps(src));
-    src += __AVX_STEP__;
-    dst += __AVX_STEP__;
+    r[i] = _mm512_shuffle_f32x4(t[i], t[i + 8], 0x88);
+    r[i + 8] = _mm512_shuffle_f32x4(t[i], t[i + 8], 0xDD);
+    r[i + 4] = _mm512_shuffle_f32x4(t[i + 4], t[i + 12], 0x88);
+    r[i + 12] = _mm512_shuffle_f32x4(t[i + 4], t[i + 12], 0xDD);
   }
+
+#pragma GCC unroll 16
+  for (size_t j = 0; j != 16; ++j)
+    if (j < columns)
+      _mm512_mask_storeu_ps(dst + j * ldd, store_mask, r[j]);
 }
 
-[[nodiscard]] f32 compute_norm(NORM_DIRECTION df, const f32* matrix, size_t size)
+static void transpose_block(const f32* __restrict__ src,
+                            size_t lds,
+                            f32* __restrict__ dst,
+                            size_t ldd,
+                            size_t rows,
+                            size_t columns)
 {
-  f32 max_norm = DBL_MIN;
-  size_t aligned_size = compute_aligned_size(size);
+  for (size_t i = 0; i < rows; i += __AVX_STEP__)
+    for (size_t j = 0; j < columns; j += __AVX_STEP__)
+      transpose_tile(src + i * lds + j,
+                     lds,
+                     dst + j * ldd + i,
+                     ldd,
+                     rows - i < __AVX_STEP__ ? rows - i : __AVX_STEP__,
+                     columns - j < __AVX_STEP__ ? columns - j : __AVX_STEP__);
+}
 
-  if (df == ROW)
-  {
-    for (size_t i = 0; i != size; ++i)
-    {
-      f32 current_norm = 0.0f;
-      const f32* curr_matrix = matrix + i * aligned_size;
+static f32 abs_sum(const f32* row, size_t count)
+{
+  __m512 sum = _mm512_setzero_ps();
+  size_t j = 0;
 
-      for (size_t j = 0; j != size; ++j)
-        current_norm += fabs(curr_matrix[j]);
+  for (; j + __AVX_STEP__ <= count; j += __AVX_STEP__)
+    sum = _mm512_add_ps(sum, _mm512_abs_ps(_mm512_loadu_ps(row + j)));
 
-      if (current_norm > max_norm)
-        max_norm = current_norm;
-    }
-  }
-  else if (df == COLUMN)
-  {
-    for (size_t i = 0; i != size; ++i)
-    {
-      f32 current_norm = 0.0f;
-      const f32* curr_matrix = matrix + i;
+  sum = _mm512_add_ps(sum, _mm512_abs_ps(_mm512_maskz_loadu_ps(tail_mask(count - j), row + j)));
+  return _mm512_reduce_add_ps(sum);
+}
 
-      for (size_t j = 0; j != size; ++j)
-        current_norm += fabs(curr_matrix[j * aligned_size]);
+static void abs_accumulate(const f32* row, f32* __restrict__ sums, size_t count)
+{
+  size_t j = 0;
 
-      if (current_norm > max_norm)
-        max_norm = current_norm;
-    }
-  }
+  for (; j + __AVX_STEP__ <= count; j += __AVX_STEP__)
+    _mm512_storeu_ps(sums + j, _mm512_add_ps(_mm512_loadu_ps(sums + j), _mm512_abs_ps(_mm512_loadu_ps(row + j))));
 
-  return max_norm;
+  __mmask16 mask = tail_mask(count - j);
+  _mm512_mask_storeu_ps(sums + j, mask, _mm512_add_ps(_mm512_maskz_loadu_ps(mask, sums + j),
+                                                      _mm512_abs_ps(_mm512_maskz_loadu_ps(mask, row + j))));
 }
+
+const matrix_kernels avx512_kernels = {
+  .name = "avx512",
+  .mr = __GEMM_MR__,
+  .nr = __GEMM_NR__,
+  .mc = __GEMM_MC__,
+  .kc = __GEMM_KC__,
+  .nc = __GEMM_NC__,
+  .micro_kernel = micro_kernel,
+  .scale = scale,
+  .add = add,
+  .copy = copy,
+  .axpy = axpy,
+  .transpose_block = transpose_block,
+  .abs_sum = abs_sum,
+  .abs_accumulate = abs_accumulate
+};
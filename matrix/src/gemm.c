@@ -0,0 +1,268 @@
+#define __AVX_ALIGN__ (64UL)
+
+#define __ERROR__ "\033[1;35m[ERROR]\033[0m"
+#define __RESULT__ "\033[1;35m[RESULT]\033[0m"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "kernels.h"
+#include "thread_team.h"
+
+/*
+ * Packs an mc x kc block of A into mr-row micro-panels, each stored column by column
+ * (mr values per k). Rows past mc are zero, so the micro-kernel never branches on them.
+ */
+static void pack_A(size_t mc, size_t kc, size_t mr, const f32* A, size_t lda, f32* __restrict__ buffer)
+{
+  for (size_t ir = 0; ir < mc; ir += mr)
+  {
+    size_t rows = mc - ir < mr ? mc - ir : mr;
+    const f32* panel = A + ir * lda;
+
+    for (size_t p = 0; p != kc; ++p)
+    {
+      for (size_t r = 0; r != rows; ++r)
+        buffer[r] = panel[r * lda + p];
+
+      for (size_t r = rows; r != mr; ++r)
+        buffer[r] = 0.0f;
+
+      buffer += mr;
+    }
+  }
+}
+
+/* pack_A for A stored transposed (kc x mc): the mr values of one k are contiguous */
+static void pack_A_trans(size_t mc, size_t kc, size_t mr, const f32* A, size_t lda, f32* __restrict__ buffer)
+{
+  for (size_t ir = 0; ir < mc; ir += mr)
+  {
+    size_t rows = mc - ir < mr ? mc - ir : mr;
+    const f32* panel = A + ir;
+
+    for (size_t p = 0; p != kc; ++p)
+    {
+      memcpy(buffer, panel + p * lda, rows * sizeof(f32));
+      memset(buffer + rows, 0, (mr - rows) * sizeof(f32));
+      buffer += mr;
+    }
+  }
+}
+
+/*
+ * Packs a kc x nc block of B into nr-column micro-panels, each stored row by row
+ * (nr values per k). Columns past nc are zero. With negate the panel holds -B,
+ * which is how GEMM_SUBTRACT costs nothing past the copy that happens anyway.
+ */
+static void pack_B(size_t kc, size_t nc, size_t nr, const f32* B, size_t ldb, bool negate, f32* __restrict__ buffer)
+{
+  for (size_t jr = 0; jr < nc; jr += nr)
+  {
+    size_t columns = nc - jr < nr ? nc - jr : nr;
+    const f32* panel = B + jr;
+
+    for (size_t p = 0; p != kc; ++p)
+    {
+      if (negate)
+        for (size_t j = 0; j != columns; ++j)
+          buffer[j] = -panel[p * ldb + j];
+      else
+        memcpy(buffer, panel + p * ldb, columns * sizeof(f32));
+
+      memset(buffer + columns, 0, (nr - columns) * sizeof(f32));
+      buffer += nr;
+    }
+  }
+}
+
+/* pack_B for B stored transposed (nc x kc): each row of storage fills one column of a panel */
+static void pack_B_trans(size_t kc, size_t nc, size_t nr, const f32* B, size_t ldb, bool negate, f32* __restrict__ buffer)
+{
+  f32 sign = negate ? -1.0f : 1.0f;
+
+  for (size_t jr = 0; jr < nc; jr += nr)
+  {
+    size_t columns = nc - jr < nr ? nc - jr : nr;
+    const f32* panel = B + jr * ldb;
+
+    for (size_t j = 0; j != columns; ++j)
+      for (size_t p = 0; p != kc; ++p)
+        buffer[p * nr + j] = sign * panel[j * ldb + p];
+
+    for (size_t p = 0; p != kc; ++p)
+      memset(buffer + p * nr + columns, 0, (nr - columns) * sizeof(f32));
+
+    buffer += kc * nr;
+  }
+}
+
+typedef struct gemm_context
+{
+  const matrix_kernels* kernels;
+  const f32* A;
+  size_t lda;
+  const f32* B;
+  size_t ldb;
+  f32* C;
+  size_t ldc;
+  size_t m;
+  size_t jc;
+  size_t nc;
+  size_t pc;
+  size_t kc;
+  GEMM_FLAGS flags;
+  f32* packed_A;
+  f32* packed_B;
+} gemm_context;
+
+static void pack_B_task(void* context, size_t begin, size_t end, [[maybe_unused]] size_t thread)
+{
+  gemm_context* gemm = context;
+  size_t nr = gemm->kernels->nr;
+  size_t jr = begin * nr;
+  size_t nc = end * nr < gemm->nc ? end * nr : gemm->nc;
+  bool negate = (gemm->flags & GEMM_SUBTRACT) != 0;
+
+  if ((gemm->flags & GEMM_TRANS_B) != 0)
+    pack_B_trans(gemm->kc, nc - jr, nr, gemm->B + (gemm->jc + jr) * gemm->ldb + gemm->pc, gemm->ldb, negate, gemm->packed_B + jr * gemm->kc);
+  else
+    pack_B(gemm->kc, nc - jr, nr, gemm->B + gemm->pc * gemm->ldb + gemm->jc + jr, gemm->ldb, negate, gemm->packed_B + jr * gemm->kc);
+}
+
+/*
+ * Packs one MC block of A into the member's own buffer and sweeps it over the shared B panel.
+ * With GEMM_UPPER, blocks and tiles that lie entirely below the diagonal are skipped.
+ */
+static void macro_task(void* context, size_t begin, size_t end, size_t thread)
+{
+  gemm_context* gemm = context;
+  const matrix_kernels* kernels = gemm->kernels;
+  size_t kc = gemm->kc;
+  f32* packed_A = gemm->packed_A + thread * kernels->mc * kernels->kc;
+  bool upper = (gemm->flags & GEMM_UPPER) != 0;
+
+  for (size_t ic = begin * kernels->mc; ic < end * kernels->mc && ic < gemm->m; ic += kernels->mc)
+  {
+    size_t mc = gemm->m - ic < kernels->mc ? gemm->m - ic : kernels->mc;
+
+    if (upper == true && ic >= gemm->jc + gemm->nc)
+      continue;
+
+    if ((gemm->flags & GEMM_TRANS_A) != 0)
+      pack_A_trans(mc, kc, kernels->mr, gemm->A + gemm->pc * gemm->lda + ic, gemm->lda, packed_A);
+    else
+      pack_A(mc, kc, kernels->mr, gemm->A + ic * gemm->lda + gemm->pc, gemm->lda, packed_A);
+
+    for (size_t jr = 0; jr < gemm->nc; jr += kernels->nr)
+      for (size_t ir = 0; ir < mc; ir += kernels->mr)
+      {
+        size_t nr = gemm->nc - jr < kernels->nr ? gemm->nc - jr : kernels->nr;
+
+        if (upper == true && ic + ir >= gemm->jc + jr + nr)
+          break;
+
+        kernels->micro_kernel(kc,
+                              packed_A + ir * kc,
+                              gemm->packed_B + jr * kc,
+                              gemm->C + (ic + ir) * gemm->ldc + gemm->jc + jr,
+                              gemm->ldc,
+                              mc - ir < kernels->mr ? mc - ir : kernels->mr,
+                              nr,
+                              (gemm->flags & GEMM_ACCUMULATE) != 0 || gemm->pc != 0);
+      }
+  }
+}
+
+/*
+ * C (m x n) = (or +=) op(A) (m x k) * op(B) (k x n), row-major with leading dimensions.
+ * BLIS loop order: NC columns of B stay in L3, a KC x NC panel is packed once and
+ * reused by every MC x KC block of A packed into L2, whose micro-panels meet the
+ * L1-resident micro-panels of B in the micro-kernel. The team packs the B panel
+ * together and then splits the MC blocks, every member packing its own A block.
+ */
+void gemm(size_t m,
+          size_t n,
+          size_t k,
+          const f32* A,
+          size_t lda,
+          const f32* B,
+          size_t ldb,
+          f32* __restrict__ C,
+          size_t ldc,
+          GEMM_FLAGS flags)
+{
+  const matrix_kernels* kernels = active_kernels();
+  gemm_context context = {
+    .kernels = kernels,
+    .A = A,
+    .lda = lda,
+    .B = B,
+    .ldb = ldb,
+    .C = C,
+    .ldc = ldc,
+    .m = m,
+    .flags = flags,
+    .packed_A = aligned_alloc(__AVX_ALIGN__, team_size() * kernels->mc * kernels->kc * sizeof(f32)),
+    .packed_B = aligned_alloc(__AVX_ALIGN__, kernels->kc * kernels->nc * sizeof(f32))
+  };
+
+  if (context.packed_A == NULL || context.packed_B == NULL)
+  {
+    fprintf(stderr,
+            "%s Cannot allocate memory\n"
+            "%s Terminating process...\n",
+            __ERROR__,
+            __RESULT__);
+    exit(EXIT_FAILURE);
+  }
+
+  if (k == 0 && (flags & GEMM_ACCUMULATE) == 0)
+    for (size_t i = 0; i != m; ++i)
+      memset(C + i * ldc, 0, n * sizeof(f32));
+
+  for (context.jc = 0; context.jc < n; context.jc += kernels->nc)
+  {
+    context.nc = n - context.jc < kernels->nc ? n - context.jc : kernels->nc;
+
+    for (context.pc = 0; context.pc < k; context.pc += kernels->kc)
+    {
+      context.kc = k - context.pc < kernels->kc ? k - context.pc : kernels->kc;
+      team_parallel_for((context.nc + kernels->nr - 1) / kernels->nr, 8, pack_B_task, &context);
+      team_parallel_for((m + kernels->mc - 1) / kernels->mc, 1, macro_task, &context);
+    }
+  }
+
+  free(context.packed_A);
+  free(context.packed_B);
+}
+
+typedef struct mirror_context
+{
+  f32* C;
+  size_t ldc;
+} mirror_context;
+
+/* Copies the upper triangle into rows [begin, end) of the lower one */
+static void mirror_task(void* context, size_t begin, size_t end, [[maybe_unused]] size_t thread)
+{
+  mirror_context* mirror = context;
+
+  for (size_t i = begin; i != end; ++i)
+    for (size_t j = 0; j != i; ++j)
+      mirror->C[i * mirror->ldc + j] = mirror->C[j * mirror->ldc + i];
+}
+
+/*
+ * C = A^T A (SYRK): the GEMM reads A transposed while packing and computes only
+ * the tiles that reach the upper triangle, about half the FLOPs, then the
+ * strictly lower triangle is mirrored from the upper one.
+ */
+void syrk(size_t n, size_t k, const f32* A, size_t lda, f32* __restrict__ C, size_t ldc)
+{
+  gemm(n, n, k, A, lda, A, lda, C, ldc, GEMM_TRANS_A | GEMM_UPPER);
+
+  mirror_context context = {.C = C, .ldc = ldc};
+  team_parallel_for(n, 16, mirror_task, &context);
+}
@@ -0,0 +1,186 @@
+/* Columns of the panel factored without GEMM, and rows of a triangular solve block */
+#define __LU_BLOCK__ (64UL)
+/* Right-hand-side columns of a triangular solve handed to a team member at once */
+#define __TRSM_GRAIN__ (64UL)
+
+#include <stddef.h>
+#include <math.h>
+#include "matrix.h"
+#include "kernels.h"
+#include "thread_team.h"
+
+static void swap_rows(f32* A, size_t ld, size_t i, size_t j, size_t columns)
+{
+  if (i == j)
+    return;
+
+  f32* lhs = A + i * ld;
+  f32* rhs = A + j * ld;
+
+  for (size_t c = 0; c != columns; ++c)
+  {
+    f32 value = lhs[c];
+    lhs[c] = rhs[c];
+    rhs[c] = value;
+  }
+}
+
+/*
+ * Unblocked LU of the panel A[k:n, k:k+b] with partial pivoting. Row swaps span
+ * the whole matrix, so L to the left and the trailing columns follow the panel.
+ */
+static bool factor_panel(f32* A, size_t n, size_t ld, size_t k, size_t b, size_t* pivots)
+{
+  const matrix_kernels* kernels = active_kernels();
+
+  for (size_t j = k; j != k + b; ++j)
+  {
+    size_t pivot = j;
+    f32 max_value = fabsf(A[j * ld + j]);
+
+    for (size_t i = j + 1; i < n; ++i)
+      if (fabsf(A[i * ld + j]) > max_value)
+      {
+        max_value = fabsf(A[i * ld + j]);
+        pivot = i;
+      }
+
+    pivots[j] = pivot;
+
+    if (max_value == 0.0f || isfinite(max_value) == 0)
+      return false;
+
+    swap_rows(A, ld, j, pivot, n);
+    f32 inverse_pivot = 1.0f / A[j * ld + j];
+
+    for (size_t i = j + 1; i < n; ++i)
+    {
+      f32* row = A + i * ld;
+      row[j] *= inverse_pivot;
+      kernels->axpy(-row[j], A + j * ld + j + 1, row + j + 1, k + b - j - 1);
+    }
+  }
+
+  return true;
+}
+
+typedef struct trsm_context
+{
+  const matrix_kernels* kernels;
+  TRIANGLE triangle;
+  const f32* T;
+  size_t n;
+  size_t ldt;
+  f32* B;
+  size_t ldb;
+} trsm_context;
+
+/* Substitution over the columns [begin, end) of B, one row operation per nonzero of T */
+static void trsm_task(void* context, size_t begin, size_t end, [[maybe_unused]] size_t thread)
+{
+  trsm_context* trsm = context;
+  size_t width = end - begin;
+  f32* B = trsm->B + begin;
+
+  if (trsm->triangle == LOWER_UNIT)
+  {
+    for (size_t i = 1; i < trsm->n; ++i)
+      for (size_t p = 0; p != i; ++p)
+        trsm->kernels->axpy(-trsm->T[i * trsm->ldt + p], B + p * trsm->ldb, B + i * trsm->ldb, width);
+  }
+  else
+  {
+    for (size_t i = trsm->n; i-- != 0;)
+    {
+      for (size_t p = i + 1; p < trsm->n; ++p)
+        trsm->kernels->axpy(-trsm->T[i * trsm->ldt + p], B + p * trsm->ldb, B + i * trsm->ldb, width);
+
+      trsm->kernels->scale(B + i * trsm->ldb, width, 1.0f / trsm->T[i * trsm->ldt + i]);
+    }
+  }
+}
+
+static void trsm_block(TRIANGLE triangle, const f32* T, size_t n, size_t ldt, f32* B, size_t ldb, size_t nrhs)
+{
+  trsm_context context = {
+    .kernels = active_kernels(),
+    .triangle = triangle,
+    .T = T,
+    .n = n,
+    .ldt = ldt,
+    .B = B,
+    .ldb = ldb
+  };
+
+  team_parallel_for(nrhs, __TRSM_GRAIN__, trsm_task, &context);
+}
+
+/*
+ * Blocked triangular solve: substitution on a diagonal block of rows, then the
+ * solved rows are eliminated from the remaining ones with one GEMM.
+ */
+void trsm(TRIANGLE triangle, const f32* T, size_t n, size_t ldt, f32* B, size_t ldb, size_t nrhs)
+{
+  if (triangle == LOWER_UNIT)
+  {
+    for (size_t k = 0; k < n; k += __LU_BLOCK__)
+    {
+      size_t b = n - k < __LU_BLOCK__ ? n - k : __LU_BLOCK__;
+      trsm_block(triangle, T + k * ldt + k, b, ldt, B + k * ldb, ldb, nrhs);
+
+      if (k + b < n)
+        gemm(n - k - b, nrhs, b, T + (k + b) * ldt + k, ldt, B + k * ldb, ldb, B + (k + b) * ldb, ldb, GEMM_ACCUMULATE | GEMM_SUBTRACT);
+    }
+  }
+  else
+  {
+    for (size_t k = n == 0 ? 0 : (n - 1) / __LU_BLOCK__ * __LU_BLOCK__;; k -= __LU_BLOCK__)
+    {
+      size_t b = n - k < __LU_BLOCK__ ? n - k : __LU_BLOCK__;
+      trsm_block(triangle, T + k * ldt + k, b, ldt, B + k * ldb, ldb, nrhs);
+
+      if (k == 0)
+        break;
+
+      gemm(k, nrhs, b, T + k, ldt, B + k * ldb, ldb, B, ldb, GEMM_ACCUMULATE | GEMM_SUBTRACT);
+    }
+  }
+}
+
+void trsv(TRIANGLE triangle, const f32* T, size_t n, size_t ldt, f32* x)
+{
+  trsm(triangle, T, n, ldt, x, 1, 1);
+}
+
+/*
+ * Right-looking blocked LU (getrf): factor a panel of __LU_BLOCK__ columns,
+ * solve for the block row of U (U12 = L11^-1 A12) and update the trailing matrix
+ * A22 -= L21 U12 with the parallel GEMM, which carries O(n^3) of the work.
+ */
+bool lu_factor(f32* A, size_t n, size_t ld, size_t* pivots)
+{
+  for (size_t k = 0; k < n; k += __LU_BLOCK__)
+  {
+    size_t b = n - k < __LU_BLOCK__ ? n - k : __LU_BLOCK__;
+
+    if (factor_panel(A, n, ld, k, b, pivots) == false)
+      return false;
+
+    if (k + b == n)
+      break;
+
+    trsm_block(LOWER_UNIT, A + k * ld + k, b, ld, A + k * ld + k + b, ld, n - k - b);
+    gemm(n - k - b, n - k - b, b, A + (k + b) * ld + k, ld, A + k * ld + k + b, ld, A + (k + b) * ld + k + b, ld, GEMM_ACCUMULATE | GEMM_SUBTRACT);
+  }
+
+  return true;
+}
+
+void lu_solve(const f32* LU, size_t n, size_t ld, const size_t* pivots, f32* B, size_t ldb, size_t nrhs)
+{
+  for (size_t i = 0; i != n; ++i)
+    swap_rows(B, ldb, i, pivots[i], nrhs);
+
+  trsm(LOWER_UNIT, LU, n, ld, B, ldb, nrhs);
+  trsm(UPPER, LU, n, ld, B, ldb, nrhs);
+}
@@ -1,4 +1,5 @@
 #define __BASE__ (10)
+#define __TOLERANCE__ (1e-4f)
 #define __ERROR__ "\033[1;34m[ERROR]\033[0m"
 #define __MESSAGE__ "\033[1;37m[MESSAGE]\033[0m"
 #define __RESULT__ "\033[1;35m[RESULT]\033[0m"
@@ -6,8 +7,10 @@
 #include <stdio.h>
 #include <inttypes.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <time.h>
+#include <unistd.h>
 #include "matrix.h"
 
 static void check_args(int32_t, char**);
@@ -20,15 +23,30 @@ int32_t main(int32_t argc, char* argv[])
 
   size_t size = strtoull(argv[1], NULL, __BASE__);
   size_t iterations = strtoull(argv[2], NULL, __BASE__);
+  size_t threads = argc >= 4 ? strtoull(argv[3], NULL, __BASE__) : (size_t)sysconf(_SC_NPROCESSORS_ONLN);
+  INVERSE_MODE mode = argc == 5 && strcmp(argv[4], "doubling") == 0 ? NEUMANN_DOUBLING : NEUMANN_SERIES;
+  bool newton = argc == 5 && strcmp(argv[4], "newton") == 0;
+
+  create_team(threads, false);
+  printf("Matrix backend : %s\n", matrix_backend());
 
   f32* matrix = create_matrix(size);
   fill_matrix(matrix, size);
 
-  clock_t begin = clock();
-  f32* inv_matrix = inverse(matrix, size, iterations);
+  /* Wall time, clock() would add up the CPU time of every team member */
+  struct timespec begin;
+  timespec_get(&begin, TIME_UTC);
+  inverse_status status;
+  f32* inv_matrix = newton == true ? inverse_newton(matrix, size, iterations, __TOLERANCE__, &status)
+                                   : inverse_mode(mode, matrix, size, iterations);
+
+  struct timespec end;
+  timespec_get(&end, TIME_UTC);
+  printf("Inverse matrix computation : %f sec\n", (double)(end.tv_sec - begin.tv_sec) + (double)(end.tv_nsec - begin.tv_nsec) * 1e-9);
+
+  if (newton == true)
+    printf("Newton-Schulz : %zu iterations, residual %g\n", status.iterations, status.residual);
 
-  clock_t end = clock();
-  printf("Inverse matrix computation : %f sec\n", (double)(end - begin) / CLOCKS_PER_SEC);
   f32* tmp = create_matrix(size);
   mul_matrix(matrix, inv_matrix, tmp, size);
   print_matrix(tmp, size);
@@ -36,17 +54,18 @@ int32_t main(int32_t argc, char* argv[])
   free(matrix);
   free(inv_matrix);
   free(tmp);
+  delete_team();
 
   return EXIT_SUCCESS;
 }
 
 static void check_args(int32_t argc, char** argv)
 {
-  if (argc != 3)
+  if (argc < 3 || argc > 5)
   {
     fprintf(stderr
             , "%s Invalid number of arguments\n"
-              "%s Two parameters was required : <size> <iterations>\n"
+              "%s Two parameters was required : <size> <iterations> <threads> (optional) <series|doubling|newton> (optional)\n"
               "%s Terminating process...\n"
             , __ERROR__
             , __MESSAGE__
@@ -79,6 +98,26 @@ static void check_args(int32_t argc, char** argv)
     valid_input = false;
   }
 
+  if (argc >= 4 && atoi(argv[3]) <= 0)
+  {
+    fprintf(stderr
+            , "%s Invalid argument\n"
+              "%s The number of threads cannot be negative or equal to zero\n"
+            , __ERROR__
+            , __MESSAGE__);
+    valid_input = false;
+  }
+
+  if (argc == 5 && strcmp(argv[4], "series") != 0 && strcmp(argv[4], "doubling") != 0 && strcmp(argv[4], "newton") != 0)
+  {
+    fprintf(stderr
+            , "%s Invalid argument\n"
+              "%s The inverse mode must be series, doubling or newton\n"
+            , __ERROR__
+            , __MESSAGE__);
+    valid_input = false;
+  }
+
   if (valid_input == false)
   {
     fprintf(stderr
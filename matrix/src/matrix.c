@@ -1,40 +1,116 @@
 #define __AVX_ALIGN__ (64UL)
-#define __BLOCK_SIZE__ (16UL)
+
+/* Rows of a streaming element-wise operation handed to a team member at once (about 64 KiB) */
+#define __STREAM_GRAIN__(columns) ((16384UL + (columns)) / ((columns) + 1UL))
+/* Side of the square cache tile a transpose works on (16 KiB) */
+#define __TRANSPOSE_TILE__ (64UL)
+/* Columns summed together by one column norm task */
+#define __NORM_BLOCK__ (64UL)
 
 #define __ERROR__ "\033[1;35m[ERROR]\033[0m"
+#define __MESSAGE__ "\033[1;37m[MESSAGE]\033[0m"
 #define __RESULT__ "\033[1;35m[RESULT]\033[0m"
 
 #define compute_aligned_size(size) ((size) + (__AVX_ALIGN__ - ((size) & 63)))
-#define min(param1, param2) ((param1) > (param2) ? (param2) : (param1))
+/* Floats per 64-byte line, the granularity of tight row padding */
+#define __ROW_ALIGN__ (16UL)
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
 #include <float.h>
 #include <math.h>
+#include <string.h>
 #include "matrix.h"
+#include "kernels.h"
+#include "thread_team.h"
 
-[[nodiscard]] f32* create_matrix(size_t size)
+static const matrix_kernels* kernels = &scalar_kernels;
+
+/*
+ * Binds the widest backend the CPU supports before main runs, so one binary
+ * built for the baseline target still uses AVX2 or AVX-512 where present.
+ * NOP_MATRIX_BACKEND=scalar|avx2|avx512 forces a backend (e.g. to compare them).
+ */
+__attribute__((constructor)) static void select_kernels(void)
 {
-  size_t aligned_size = compute_aligned_size(size);
-  aligned_size *= aligned_size;
-  f32* matrix = aligned_alloc(__AVX_ALIGN__, aligned_size << 2);
+  __builtin_cpu_init();
+  bool has_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  bool has_avx512 = __builtin_cpu_supports("avx512f");
+
+  if (has_avx512 == true)
+    kernels = &avx512_kernels;
+  else if (has_avx2 == true)
+    kernels = &avx2_kernels;
+
+  const char* forced = getenv("NOP_MATRIX_BACKEND");
+
+  if (forced == NULL)
+    return;
+
+  if (strcmp(forced, scalar_kernels.name) == 0)
+    kernels = &scalar_kernels;
+  else if (strcmp(forced, avx2_kernels.name) == 0 && has_avx2 == true)
+    kernels = &avx2_kernels;
+  else if (strcmp(forced, avx512_kernels.name) == 0 && has_avx512 == true)
+    kernels = &avx512_kernels;
+  else
+    fprintf(stderr,
+            "%s Unsupported matrix backend\n"
+            "%s NOP_MATRIX_BACKEND=%s, using %s\n",
+            __ERROR__,
+            __MESSAGE__,
+            forced,
+            kernels->name);
+}
+
+const matrix_kernels* active_kernels(void)
+{
+  return kernels;
+}
+
+const char* matrix_backend(void)
+{
+  return kernels->name;
+}
+
+/* Uninitialized storage, for buffers that are fully written before being read */
+static f32* allocate_matrix(size_t count)
+{
+  f32* matrix = aligned_alloc(__AVX_ALIGN__, count << 2);
 
   if (matrix == NULL)
   {
     fprintf(stderr,
-        "%s Cannot allocate memory\n"
-        "%s Terminating process...\n",
-        __ERROR__,
-        __RESULT__);
+            "%s Cannot allocate memory\n"
+            "%s Terminating process...\n",
+            __ERROR__,
+            __RESULT__);
     exit(EXIT_FAILURE);
   }
 
-  f32* end = matrix + aligned_size;
+  return matrix;
+}
+
+[[nodiscard]] f32* create_matrix(size_t size)
+{
+  size_t aligned_size = compute_aligned_size(size);
+  f32* matrix = allocate_matrix(aligned_size * aligned_size);
+  memset(matrix, 0, (aligned_size * aligned_size) << 2);
+
+  return matrix;
+}
+
+size_t leading_dimension(size_t columns)
+{
+  return (columns + __ROW_ALIGN__ - 1) & ~(__ROW_ALIGN__ - 1);
+}
+
+[[nodiscard]] f32* create_matrix_mn(size_t rows, size_t columns)
+{
+  f32* matrix = allocate_matrix(rows * leading_dimension(columns));
+  memset(matrix, 0, (rows * leading_dimension(columns)) << 2);
 
-  for (f32* begin = matrix; begin != end; ++begin)
-    *begin = 0.0f;
-  
   return matrix;
 }
 
@@ -49,59 +125,159 @@
   return matrix;
 }
 
-[[nodiscard]] f32* transpose(f32* matrix,
-                             size_t size)
+typedef struct transpose_context
+{
+  const f32* matrix;
+  size_t lds;
+  f32* t_matrix;
+  size_t ldd;
+  size_t rows;
+  size_t columns;
+  size_t column_tiles;
+} transpose_context;
+
+/* Items are cache tiles of the source, numbered row by row */
+static void transpose_task(void* context, size_t begin, size_t end, [[maybe_unused]] size_t thread)
+{
+  transpose_context* t = context;
+
+  for (size_t tile = begin; tile != end; ++tile)
+  {
+    size_t i = tile / t->column_tiles * __TRANSPOSE_TILE__;
+    size_t j = tile % t->column_tiles * __TRANSPOSE_TILE__;
+
+    kernels->transpose_block(t->matrix + i * t->lds + j,
+                       t->lds,
+                       t->t_matrix + j * t->ldd + i,
+                       t->ldd,
+                       t->rows - i < __TRANSPOSE_TILE__ ? t->rows - i : __TRANSPOSE_TILE__,
+                       t->columns - j < __TRANSPOSE_TILE__ ? t->columns - j : __TRANSPOSE_TILE__);
+  }
+}
+
+/*
+ * Out-of-place transpose in cache tiles: a tile of the source and of the
+ * destination both stay in L1 while the backend transposes it in registers,
+ * so neither side is walked column by column across the whole matrix.
+ */
+void transpose_mn(const f32* __restrict__ matrix,
+                  size_t rows,
+                  size_t columns,
+                  size_t lds,
+                  f32* __restrict__ t_matrix,
+                  size_t ldd)
+{
+  size_t row_tiles = (rows + __TRANSPOSE_TILE__ - 1) / __TRANSPOSE_TILE__;
+  size_t column_tiles = (columns + __TRANSPOSE_TILE__ - 1) / __TRANSPOSE_TILE__;
+  transpose_context context = {
+    .matrix = matrix,
+    .lds = lds,
+    .t_matrix = t_matrix,
+    .ldd = ldd,
+    .rows = rows,
+    .columns = columns,
+    .column_tiles = column_tiles
+  };
+
+  team_parallel_for(row_tiles * column_tiles, 4, transpose_task, &context);
+}
+
+/* Swaps tile (I, J) with the transpose of tile (J, I) for every J >= I of the tile rows [begin, end) */
+static void transpose_inplace_task(void* context, size_t begin, size_t end, [[maybe_unused]] size_t thread)
+{
+  transpose_context* t = context;
+  f32 buffer[__TRANSPOSE_TILE__ * __TRANSPOSE_TILE__];
+  size_t size = t->rows;
+  size_t ld = t->lds;
+  f32* matrix = t->t_matrix;
+
+  for (size_t tile = begin; tile != end; ++tile)
+  {
+    size_t i = tile * __TRANSPOSE_TILE__;
+    size_t height = size - i < __TRANSPOSE_TILE__ ? size - i : __TRANSPOSE_TILE__;
+
+    for (size_t j = i; j < size; j += __TRANSPOSE_TILE__)
+    {
+      size_t width = size - j < __TRANSPOSE_TILE__ ? size - j : __TRANSPOSE_TILE__;
+
+      /* buffer = (A_IJ)^T, A_IJ = (A_JI)^T, A_JI = buffer */
+      kernels->transpose_block(matrix + i * ld + j, ld, buffer, __TRANSPOSE_TILE__, height, width);
+
+      if (j != i)
+        kernels->transpose_block(matrix + j * ld + i, ld, matrix + i * ld + j, ld, width, height);
+
+      for (size_t r = 0; r != width; ++r)
+        kernels->copy(buffer + r * __TRANSPOSE_TILE__, matrix + (j + r) * ld + i, height);
+    }
+  }
+}
+
+/* In-place transpose of a square matrix, tile pairs across the diagonal are swapped through a stack buffer */
+void transpose_inplace(f32* matrix, size_t size, size_t ld)
+{
+  transpose_context context = {.lds = ld, .t_matrix = matrix, .ldd = ld, .rows = size, .columns = size};
+  team_parallel_for((size + __TRANSPOSE_TILE__ - 1) / __TRANSPOSE_TILE__, 1, transpose_inplace_task, &context);
+}
+
+[[nodiscard]] f32* transpose(f32* matrix, size_t size)
 {
-  f32* t_matrix = __builtin_assume_aligned(create_matrix(size), __AVX_ALIGN__);
   size_t aligned_size = compute_aligned_size(size);
+  f32* t_matrix = __builtin_assume_aligned(allocate_matrix(aligned_size * aligned_size), __AVX_ALIGN__);
 
-  for (size_t i = 0; i != size; ++i)
-    for (size_t j = 0; j != size; ++j)
-      t_matrix[j * aligned_size + i] = matrix[i * aligned_size + j];
+  transpose_mn(matrix, size, size, aligned_size, t_matrix, aligned_size);
 
   return t_matrix;
 }
 
-[[nodiscard]] static f32* create_B(f32* matrix,
-                                   size_t size)
+/* Scale of B = A^T / (||A||_1 ||A||_inf), ||A^T||_inf being the column norm of A */
+[[nodiscard]] static f32 compute_scalar(const f32* matrix, size_t size)
+{
+  return 1 / (compute_norm(ROW, matrix, size) *
+              compute_norm(COLUMN, matrix, size));
+}
+
+[[nodiscard]] static f32* create_B(f32* matrix, size_t size)
 {
-  f32* B = __builtin_assume_aligned(transpose(matrix, size), __AVX_ALIGN__);
-  f32 scalar = 1 / (compute_norm(ROW, matrix, size) *
-                    compute_norm(ROW, B, size));
-  muls_matrix(B, size, scalar);
+  size_t aligned_size = compute_aligned_size(size);
+  f32* B = __builtin_assume_aligned(allocate_matrix(aligned_size * aligned_size), __AVX_ALIGN__);
+  transpose_mn(matrix, size, size, aligned_size, B, aligned_size);
+  muls_matrix(B, size, compute_scalar(matrix, size));
 
   return B;
 }
 
-[[nodiscard]] static f32* create_R(f32* B,
-                                   f32* A,
-                                   size_t size)
+/* Logical part of an allocated square matrix set to the identity */
+static void set_identity(f32* matrix, size_t size)
 {
-  f32* R = __builtin_assume_aligned(create_matrix(size), __AVX_ALIGN__);
   size_t aligned_size = compute_aligned_size(size);
 
-  mul_matrix(B, A, R, size);
-  muls_matrix(R, size, -1.0f);
-  
   for (size_t i = 0; i != size; ++i)
-    R[i * aligned_size + i] += 1.0f;
-
-  return R;
+  {
+    memset(matrix + i * aligned_size, 0, size << 2);
+    matrix[i * aligned_size + i] = 1.0f;
+  }
 }
 
-[[nodiscard]] f32* inverse(f32* A,
-                           size_t N,
-                           size_t M)
+/* R = I - B A, where B A = scalar A^T A is symmetric and formed by SYRK straight from A */
+static void compute_R(const f32* A, size_t size, f32 scalar, f32* __restrict__ R)
 {
-  if (M == 0)
-    return create_matrix(N);
+  size_t aligned_size = compute_aligned_size(size);
 
-  f32* B = __builtin_assume_aligned(create_B(A, N), __AVX_ALIGN__);
-  f32* R = __builtin_assume_aligned(create_R(B, A, N), __AVX_ALIGN__);
-  f32* R_curr = __builtin_assume_aligned(create_matrix(N), __AVX_ALIGN__);
+  syrk(size, size, A, aligned_size, R, aligned_size);
+  muls_matrix(R, size, -scalar);
+
+  for (size_t i = 0; i != size; ++i)
+    R[i * aligned_size + i] += 1.0f;
+}
+
+/*
+ * accum = I + R + R^2 + ... + R^(M-1), one GEMM per term. R_prev is written
+ * before it is read, so neither scratch buffer needs initializing.
+ */
+static void neumann_series(const f32* R, size_t N, size_t M, f32* accum, f32* R_curr, f32* R_prev)
+{
+  set_identity(accum, N);
   copy_matrix(R, R_curr, N);
-  f32* R_prev = __builtin_assume_aligned(create_identity(N), __AVX_ALIGN__);
-  f32* accum = __builtin_assume_aligned(create_identity(N), __AVX_ALIGN__);
 
   for (size_t i = 1; i != M; ++i)
   {
@@ -109,144 +285,409 @@
     copy_matrix(R_curr, R_prev, N);
     mul_matrix(R_prev, R, R_curr, N);
   }
+}
+
+/*
+ * The same partial sum S_M = I + R + ... + R^(M-1) built from the bits of M,
+ * most significant first, keeping P = R^n next to S_n:
+ *   doubling   S_2n = S_n (I + R^n) = S_n + S_n P,  P = P P
+ *   next term  S_n+1 = S_n + P,                      P = P R
+ * For M = 2^k this is the product (I + R)(I + R^2)(I + R^4)... in 2k - 1 GEMMs,
+ * any M costs at most 3 log2(M).
+ */
+static void neumann_doubling(const f32* R, size_t N, size_t M, f32* accum, f32* power, f32* product)
+{
+  set_identity(accum, N);
+  copy_matrix(R, power, N);
 
-  free(R);
-  free(R_curr);
-  free(R_prev);
+  size_t bit = (size_t)1 << (sizeof(size_t) * 8 - 1 - __builtin_clzl(M));
 
-  f32* inv_A = __builtin_assume_aligned(create_matrix(N), __AVX_ALIGN__);
-  mul_matrix(accum, B, inv_A, N);
+  for (bit >>= 1; bit != 0; bit >>= 1)
+  {
+    mul_matrix(accum, power, product, N);
+    sum_matrix(accum, product, accum, N);
 
-  free(B);
-  free(accum);
+    if (bit == 1 && (M & bit) == 0)
+      break;
 
-  return inv_A;
+    mul_matrix(power, power, product, N);
+
+    f32* swap = power;
+    power = product;
+    product = swap;
+
+    if ((M & bit) != 0)
+    {
+      sum_matrix(accum, power, accum, N);
+
+      if (bit == 1)
+        break;
+
+      mul_matrix(power, R, product, N);
+
+      swap = power;
+      power = product;
+      product = swap;
+    }
+  }
 }
 
-void fill_matrix(f32* matrix,
-                 size_t size)
+/* R, the partial sum and two scratch matrices of the Neumann series */
+struct inverse_workspace
+{
+  size_t size;
+  f32* R;
+  f32* accum;
+  f32* scratch[2];
+};
+
+[[nodiscard]] inverse_workspace* create_workspace(size_t size)
 {
-  matrix = __builtin_assume_aligned(matrix, __AVX_ALIGN__);
+  inverse_workspace* workspace = malloc(sizeof(inverse_workspace));
+
+  if (workspace == NULL)
+  {
+    fprintf(stderr,
+            "%s Cannot allocate memory\n"
+            "%s Terminating process...\n",
+            __ERROR__,
+            __RESULT__);
+    exit(EXIT_FAILURE);
+  }
+
   size_t aligned_size = compute_aligned_size(size);
-  f32* end = matrix + aligned_size * aligned_size;
+  workspace->size = size;
+  workspace->R = allocate_matrix(aligned_size * aligned_size);
+  workspace->accum = allocate_matrix(aligned_size * aligned_size);
+  workspace->scratch[0] = allocate_matrix(aligned_size * aligned_size);
+  workspace->scratch[1] = allocate_matrix(aligned_size * aligned_size);
+
+  return workspace;
+}
+
+void delete_workspace(inverse_workspace* workspace)
+{
+  if (workspace == NULL)
+    return;
+
+  free(workspace->R);
+  free(workspace->accum);
+  free(workspace->scratch[0]);
+  free(workspace->scratch[1]);
+  free(workspace);
+}
+
+void inverse_into(inverse_workspace* workspace, INVERSE_MODE mode, const f32* A, size_t M, f32* __restrict__ inv_A)
+{
+  size_t N = workspace->size;
+  size_t aligned_size = compute_aligned_size(N);
+
+  if (M == 0)
+  {
+    for (size_t i = 0; i != N; ++i)
+      memset(inv_A + i * aligned_size, 0, N << 2);
+
+    return;
+  }
+
+  f32 scalar = compute_scalar(A, N);
+  compute_R(A, N, scalar, workspace->R);
+
+  if (mode == NEUMANN_DOUBLING)
+    neumann_doubling(workspace->R, N, M, workspace->accum, workspace->scratch[0], workspace->scratch[1]);
+  else
+    neumann_series(workspace->R, N, M, workspace->accum, workspace->scratch[0], workspace->scratch[1]);
+
+  /* inv_A = accum B = scalar (accum A^T), B itself is never formed */
+  gemm(N, N, N, workspace->accum, aligned_size, A, aligned_size, inv_A, aligned_size, GEMM_TRANS_B);
+  muls_matrix(inv_A, N, scalar);
+}
+
+[[nodiscard]] f32* inverse_mode(INVERSE_MODE mode, f32* A, size_t N, size_t M)
+{
+  size_t aligned_size = compute_aligned_size(N);
+  inverse_workspace* workspace = create_workspace(N);
+  f32* inv_A = __builtin_assume_aligned(allocate_matrix(aligned_size * aligned_size), __AVX_ALIGN__);
+
+  inverse_into(workspace, mode, A, M, inv_A);
+  delete_workspace(workspace);
+
+  return inv_A;
+}
+
+[[nodiscard]] f32* inverse(f32* A, size_t N, size_t M)
+{
+  return inverse_mode(NEUMANN_SERIES, A, N, M);
+}
+
+/*
+ * Newton-Schulz iteration X <- X (2I - A X) = X + X E with E = I - A X, starting
+ * from the same X0 = A^T / (||A||_1 ||A||_inf) as the Neumann series, for which
+ * it converges quadratically. E is formed every step anyway, so its row norm is
+ * the residual check; the loop stops once it is within tolerance, after
+ * max_iterations updates, or when it stops being finite (the input is singular
+ * to working precision). status (if not NULL) receives the count of updates and
+ * the residual of the returned X.
+ */
+[[nodiscard]] f32* inverse_newton(f32* A, size_t N, size_t max_iterations, f32 tolerance, inverse_status* status)
+{
+  size_t aligned_size = compute_aligned_size(N);
+  f32* X = __builtin_assume_aligned(create_B(A, N), __AVX_ALIGN__);
+  f32* E = __builtin_assume_aligned(allocate_matrix(aligned_size * aligned_size), __AVX_ALIGN__);
+  f32* product = __builtin_assume_aligned(allocate_matrix(aligned_size * aligned_size), __AVX_ALIGN__);
+  size_t iterations = 0;
+  f32 residual;
+
+  for (;;)
+  {
+    mul_matrix(A, X, E, N);
+    muls_matrix(E, N, -1.0f);
+
+    for (size_t i = 0; i != N; ++i)
+      E[i * aligned_size + i] += 1.0f;
+
+    residual = compute_norm(ROW, E, N);
+
+    if (residual <= tolerance || iterations == max_iterations || isfinite(residual) == 0)
+      break;
+
+    mul_matrix(X, E, product, N);
+    sum_matrix(X, product, X, N);
+    ++iterations;
+  }
+
+  free(E);
+  free(product);
+
+  if (status != NULL)
+  {
+    status->iterations = iterations;
+    status->residual = residual;
+  }
+
+  return X;
+}
+
+void fill_matrix_mn(f32* matrix, size_t rows, size_t columns, size_t ld)
+{
+  for (size_t i = 0; i != rows; ++i)
+    for (size_t j = 0; j != columns; ++j)
+      matrix[i * ld + j] = rand() & 15;
+}
+
+void fill_matrix(f32* matrix, size_t size)
+{
+  fill_matrix_mn(matrix, size, size, compute_aligned_size(size));
+}
 
-  for (; matrix != end; ++matrix)
-    *matrix = rand() & 15;
+void mul_matrix_mn(size_t m,
+                   size_t n,
+                   size_t k,
+                   const f32* A,
+                   size_t lda,
+                   const f32* B,
+                   size_t ldb,
+                   f32* __restrict__ C,
+                   size_t ldc)
+{
+  gemm(m, n, k, A, lda, B, ldb, C, ldc, GEMM_DEFAULT);
 }
 
 void mul_matrix(const f32* lhs,
                 const f32* rhs,
-                f32* __restrict__ res,
-                size_t size)
+                f32* __restrict__ res, size_t size)
 {
-  lhs = __builtin_assume_aligned(lhs, __AVX_ALIGN__);
-  rhs = __builtin_assume_aligned(rhs, __AVX_ALIGN__);
-  res = __builtin_assume_aligned(res, __AVX_ALIGN__);
   size_t aligned_size = compute_aligned_size(size);
+  gemm(size, size, size, lhs, aligned_size, rhs, aligned_size, res, aligned_size, GEMM_DEFAULT);
+}
 
-  for (size_t i = 0; i != size; ++i)
-  {
-    register f32* tmp_res = res + i * aligned_size;
+typedef struct stream_context
+{
+  const f32* src;
+  size_t lds;
+  const f32* rhs;
+  size_t ldr;
+  f32* dst;
+  size_t ldd;
+  size_t columns;
+  f32 value;
+} stream_context;
+
+/* Rows that are packed back to back (ld == columns) form one contiguous run */
+static size_t stream_runs(const stream_context* stream, size_t begin, size_t end, size_t* length)
+{
+  bool packed = stream->ldd == stream->columns &&
+                (stream->src == NULL || stream->lds == stream->columns) &&
+                (stream->rhs == NULL || stream->ldr == stream->columns);
 
-    for (size_t j = 0; j != size; ++j)
-      tmp_res[j] = 0.0f;
+  *length = packed == true ? (end - begin) * stream->columns : stream->columns;
+  return packed == true ? 1 : end - begin;
+}
 
-    for (size_t j = 0; j != size; ++j)
-    {
-      register f32 tmp_lhs = lhs[i * aligned_size + j];
-      register const f32* tmp_rhs = rhs + j * aligned_size;
+static void muls_task(void* context, size_t begin, size_t end, [[maybe_unused]] size_t thread)
+{
+  stream_context* stream = context;
+  size_t length;
+  size_t runs = stream_runs(stream, begin, end, &length);
 
-      for (register size_t k = 0; k != size; ++k)
-        tmp_res[k] += tmp_lhs * (*tmp_rhs++);
-    }
-  }
+  for (size_t i = begin; i != begin + runs; ++i)
+    kernels->scale(stream->dst + i * stream->ldd, length, stream->value);
 }
 
-void muls_matrix(f32* matrix,
-                 size_t size,
-                 f32 value)
+void muls_matrix_mn(f32* matrix, size_t rows, size_t columns, size_t ld, f32 value)
+{
+  stream_context context = {.dst = matrix, .ldd = ld, .columns = columns, .value = value};
+  team_parallel_for(rows, __STREAM_GRAIN__(columns), muls_task, &context);
+}
+
+void muls_matrix(f32* matrix, size_t size, f32 value)
 {
-  matrix = __builtin_assume_aligned(matrix, __AVX_ALIGN__);
   size_t aligned_size = compute_aligned_size(size);
-  f32* end = matrix + aligned_size * aligned_size;
+  muls_matrix_mn(matrix, size, size, aligned_size, value);
+}
+
+static void sum_task(void* context, size_t begin, size_t end, [[maybe_unused]] size_t thread)
+{
+  stream_context* stream = context;
+  size_t length;
+  size_t runs = stream_runs(stream, begin, end, &length);
 
-  for (; matrix != end; ++matrix)
-    *matrix *= value;
+  for (size_t i = begin; i != begin + runs; ++i)
+    kernels->add(stream->src + i * stream->lds, stream->rhs + i * stream->ldr, stream->dst + i * stream->ldd, length);
 }
 
+void sum_matrix_mn(const f32* lhs,
+                   size_t ld_lhs,
+                   const f32* rhs,
+                   size_t ld_rhs,
+                   f32* res,
+                   size_t ld_res,
+                   size_t rows,
+                   size_t columns)
+{
+  stream_context context = {
+    .src = lhs,
+    .lds = ld_lhs,
+    .rhs = rhs,
+    .ldr = ld_rhs,
+    .dst = res,
+    .ldd = ld_res,
+    .columns = columns
+  };
+  team_parallel_for(rows, __STREAM_GRAIN__(columns), sum_task, &context);
+}
 
-void sum_matrix(f32* lhs,
-                f32* rhs,
-                f32* res,
-                size_t size)
+void sum_matrix(f32* lhs, f32* rhs, f32* res, size_t size)
 {
-  f32* begin_lhs = __builtin_assume_aligned(lhs, __AVX_ALIGN__);
-  f32* begin_rhs = __builtin_assume_aligned(rhs, __AVX_ALIGN__);
-  res = __builtin_assume_aligned(res, __AVX_ALIGN__);
   size_t aligned_size = compute_aligned_size(size);
-  f32* end = lhs + aligned_size * aligned_size;
+  sum_matrix_mn(lhs, aligned_size, rhs, aligned_size, res, aligned_size, size, size);
+}
 
-  while (begin_lhs != end)
-  {
-    *res = *begin_lhs + *begin_rhs;
-    ++res;
-    ++begin_lhs;
-    ++begin_rhs;
-  }
+static void copy_task(void* context, size_t begin, size_t end, [[maybe_unused]] size_t thread)
+{
+  stream_context* stream = context;
+  size_t length;
+  size_t runs = stream_runs(stream, begin, end, &length);
+
+  for (size_t i = begin; i != begin + runs; ++i)
+    kernels->copy(stream->src + i * stream->lds, stream->dst + i * stream->ldd, length);
+}
+
+void copy_matrix_mn(const f32* __restrict__ src,
+                    size_t lds,
+                    f32* __restrict__ dst,
+                    size_t ldd,
+                    size_t rows,
+                    size_t columns)
+{
+  stream_context context = {.src = src, .lds = lds, .dst = dst, .ldd = ldd, .columns = columns};
+  team_parallel_for(rows, __STREAM_GRAIN__(columns), copy_task, &context);
 }
 
-void copy_matrix(const f32* __restrict__ src,
-                 f32* __restrict__ dst,
-                 size_t size)
+void copy_matrix(const f32* __restrict__ src, f32* __restrict__ dst, size_t size)
 {
-  src = __builtin_assume_aligned(src, __AVX_ALIGN__);
-  dst = __builtin_assume_aligned(dst, __AVX_ALIGN__);
   size_t aligned_size = compute_aligned_size(size);
-  const f32* end = src + aligned_size * aligned_size;
+  copy_matrix_mn(src, aligned_size, dst, aligned_size, size, size);
+}
+
+typedef struct norm_context
+{
+  const f32* matrix;
+  size_t rows;
+  size_t columns;
+  size_t ld;
+  f32* partial;
+} norm_context;
+
+static void row_norm_task(void* context, size_t begin, size_t end, size_t thread)
+{
+  norm_context* norm = context;
+  f32 max_norm = norm->partial[thread];
 
-  while (src != end)
+  for (size_t i = begin; i != end; ++i)
   {
-    *dst = *src;
-    ++src;
-    ++dst;
+    f32 current_norm = kernels->abs_sum(norm->matrix + i * norm->ld, norm->columns);
+
+    if (current_norm > max_norm || isnan(current_norm))
+      max_norm = current_norm;
   }
+
+  norm->partial[thread] = max_norm;
 }
 
-f32 compute_norm(NORM_DIRECTION df,
-                 const f32* matrix,
-                 size_t size)
+/* Sums a block of columns over all rows, so rows are read contiguously */
+static void column_norm_task(void* context, size_t begin, size_t end, size_t thread)
 {
-  matrix = __builtin_assume_aligned(matrix, __AVX_ALIGN__);
-  f32 max_norm = DBL_MIN;
-  size_t aligned_size = compute_aligned_size(size);
+  norm_context* norm = context;
+  f32 max_norm = norm->partial[thread];
 
-  if (df == ROW)
+  for (size_t block = begin; block != end; ++block)
   {
-    for (size_t i = 0; i != size; ++i)
-    {
-      const f32* matrix_curr = matrix + i * aligned_size;
-      f32 norm_curr = 0.0f;
+    size_t j = block * __NORM_BLOCK__;
+    size_t width = norm->columns - j < __NORM_BLOCK__ ? norm->columns - j : __NORM_BLOCK__;
+    f32 sums[__NORM_BLOCK__] = {0};
 
-      for (size_t j = 0; j != size; ++j)
-        norm_curr += fabs(matrix_curr[j]);
+    for (size_t i = 0; i != norm->rows; ++i)
+      kernels->abs_accumulate(norm->matrix + i * norm->ld + j, sums, width);
 
-      if (norm_curr > max_norm)
-        max_norm = norm_curr;
-    }
+    for (size_t c = 0; c != width; ++c)
+      if (sums[c] > max_norm || isnan(sums[c]))
+        max_norm = sums[c];
   }
-  else
-  {
-    for (size_t i = 0; i != size; ++i)
-    {
-      f32 current_norm = 0.0f;
 
-      for (size_t j = 0; j != size; ++j)
-        current_norm += fabs(matrix[j * aligned_size + i]);
+  norm->partial[thread] = max_norm;
+}
 
-      if (current_norm > max_norm)
-        max_norm = current_norm;
-    }
-  }
+[[nodiscard]] f32 compute_norm_mn(NORM_DIRECTION df, const f32* matrix, size_t rows, size_t columns, size_t ld)
+{
+  f32 partial[team_size()];
+  norm_context context = {
+    .matrix = matrix,
+    .rows = rows,
+    .columns = columns,
+    .ld = ld,
+    .partial = partial
+  };
+
+  for (size_t i = 0; i != team_size(); ++i)
+    partial[i] = DBL_MIN;
+
+  if (df == ROW)
+    team_parallel_for(rows, __STREAM_GRAIN__(columns), row_norm_task, &context);
+  else if (df == COLUMN)
+    team_parallel_for((columns + __NORM_BLOCK__ - 1) / __NORM_BLOCK__, 1, column_norm_task, &context);
+
+  f32 max_norm = DBL_MIN;
+
+  /* A NaN norm is kept rather than skipped, so callers can detect it */
+  for (size_t i = 0; i != team_size(); ++i)
+    if (partial[i] > max_norm || isnan(partial[i]))
+      max_norm = partial[i];
 
   return max_norm;
 }
+
+[[nodiscard]] f32 compute_norm(NORM_DIRECTION df, const f32* matrix, size_t size)
+{
+  return compute_norm_mn(df, matrix, size, size, compute_aligned_size(size));
+}
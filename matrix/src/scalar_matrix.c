@@ -0,0 +1,110 @@
+/* GEMM register tile (rows x columns of C) and cache blocks, MC and NC are multiples of MR and NR */
+#define __GEMM_MR__ (4UL)
+#define __GEMM_NR__ (16UL)
+#define __GEMM_MC__ (128UL)
+#define __GEMM_KC__ (256UL)
+#define __GEMM_NC__ (2048UL)
+
+#include <stddef.h>
+#include <math.h>
+#include "kernels.h"
+
+/*
+ * C (mr x nr corner of the tile) = (or +=) packed A micro-panel * packed B micro-panel.
+ * Portable fallback: the 4 x 16 tile is a local array the compiler may keep in
+ * whatever vector registers the baseline target has.
+ */
+static void micro_kernel(size_t kc,
+                         const f32* __restrict__ a,
+                         const f32* __restrict__ b,
+                         f32* __restrict__ c,
+                         size_t ldc,
+                         size_t mr,
+                         size_t nr,
+                         bool accumulate)
+{
+  f32 acc[__GEMM_MR__][__GEMM_NR__] = {0};
+
+  for (size_t p = 0; p != kc; ++p)
+  {
+    for (size_t r = 0; r != __GEMM_MR__; ++r)
+      for (size_t j = 0; j != __GEMM_NR__; ++j)
+        acc[r][j] += a[r] * b[j];
+
+    a += __GEMM_MR__;
+    b += __GEMM_NR__;
+  }
+
+  for (size_t r = 0; r != mr; ++r)
+    for (size_t j = 0; j != nr; ++j)
+      c[r * ldc + j] = accumulate == true ? c[r * ldc + j] + acc[r][j] : acc[r][j];
+}
+
+static void scale(f32* matrix, size_t count, f32 value)
+{
+  for (size_t i = 0; i != count; ++i)
+    matrix[i] *= value;
+}
+
+static void add(const f32* lhs, const f32* rhs, f32* res, size_t count)
+{
+  for (size_t i = 0; i != count; ++i)
+    res[i] = lhs[i] + rhs[i];
+}
+
+static void copy(const f32* __restrict__ src, f32* __restrict__ dst, size_t count)
+{
+  for (size_t i = 0; i != count; ++i)
+    dst[i] = src[i];
+}
+
+static void axpy(f32 alpha, const f32* __restrict__ x, f32* __restrict__ y, size_t count)
+{
+  for (size_t i = 0; i != count; ++i)
+    y[i] += alpha * x[i];
+}
+
+static void transpose_block(const f32* __restrict__ src,
+                            size_t lds,
+                            f32* __restrict__ dst,
+                            size_t ldd,
+                            size_t rows,
+                            size_t columns)
+{
+  for (size_t i = 0; i != rows; ++i)
+    for (size_t j = 0; j != columns; ++j)
+      dst[j * ldd + i] = src[i * lds + j];
+}
+
+static f32 abs_sum(const f32* row, size_t count)
+{
+  f32 sum = 0.0f;
+
+  for (size_t j = 0; j != count; ++j)
+    sum += fabsf(row[j]);
+
+  return sum;
+}
+
+static void abs_accumulate(const f32* row, f32* __restrict__ sums, size_t count)
+{
+  for (size_t j = 0; j != count; ++j)
+    sums[j] += fabsf(row[j]);
+}
+
+const matrix_kernels scalar_kernels = {
+  .name = "scalar",
+  .mr = __GEMM_MR__,
+  .nr = __GEMM_NR__,
+  .mc = __GEMM_MC__,
+  .kc = __GEMM_KC__,
+  .nc = __GEMM_NC__,
+  .micro_kernel = micro_kernel,
+  .scale = scale,
+  .add = add,
+  .copy = copy,
+  .axpy = axpy,
+  .transpose_block = transpose_block,
+  .abs_sum = abs_sum,
+  .abs_accumulate = abs_accumulate
+};
@@ -0,0 +1,238 @@
+#define _GNU_SOURCE
+
+#define __ERROR__ "\033[1;35m[ERROR]\033[0m"
+#define __RESULT__ "\033[1;35m[RESULT]\033[0m"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include "matrix.h"
+#include "thread_team.h"
+
+/*
+ * Persistent fork-join team: the workers are created once by create_team and sleep
+ * on a condition variable between parallel loops. The calling thread is member 0
+ * and works on the loop as well; items are handed out in chunks of grain through
+ * an atomic counter, so uneven chunks balance themselves.
+ */
+typedef struct thread_team
+{
+  pthread_t* workers;
+  size_t size;
+  pthread_mutex_t lock;
+  pthread_cond_t start;
+  pthread_cond_t done;
+  size_t generation;
+  size_t running;
+  bool stop;
+  team_task task;
+  void* context;
+  size_t count;
+  size_t grain;
+  atomic_size_t next;
+  bool pinned;
+  pthread_t caller;
+  cpu_set_t caller_affinity;
+} thread_team;
+
+static thread_team team = {
+  .workers = NULL,
+  .size = 1,
+  .lock = PTHREAD_MUTEX_INITIALIZER,
+  .start = PTHREAD_COND_INITIALIZER,
+  .done = PTHREAD_COND_INITIALIZER
+};
+
+/* Set inside team members, a nested parallel loop runs serially instead of deadlocking */
+static _Thread_local bool in_team = false;
+
+static void run_chunks(size_t thread)
+{
+  for (;;)
+  {
+    size_t begin = atomic_fetch_add_explicit(&team.next, team.grain, memory_order_relaxed);
+
+    if (begin >= team.count)
+      break;
+
+    size_t end = team.count - begin < team.grain ? team.count : begin + team.grain;
+    team.task(team.context, begin, end, thread);
+  }
+}
+
+static void pin_thread(pthread_t thread, size_t index)
+{
+  cpu_set_t allowed;
+
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0)
+    return;
+
+  size_t target = index % (size_t)CPU_COUNT(&allowed);
+
+  for (size_t cpu = 0; cpu != CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &allowed) == false)
+      continue;
+
+    if (target-- == 0)
+    {
+      cpu_set_t single;
+      CPU_ZERO(&single);
+      CPU_SET(cpu, &single);
+      pthread_setaffinity_np(thread, sizeof(single), &single);
+      return;
+    }
+  }
+}
+
+static void* worker_main(void* argument)
+{
+  size_t thread = (size_t)argument;
+  size_t seen = 0;
+  in_team = true;
+
+  pthread_mutex_lock(&team.lock);
+
+  for (;;)
+  {
+    while (team.generation == seen && team.stop == false)
+      pthread_cond_wait(&team.start, &team.lock);
+
+    if (team.stop == true)
+      break;
+
+    seen = team.generation;
+    pthread_mutex_unlock(&team.lock);
+
+    run_chunks(thread);
+
+    pthread_mutex_lock(&team.lock);
+
+    if (--team.running == 0)
+      pthread_cond_signal(&team.done);
+  }
+
+  pthread_mutex_unlock(&team.lock);
+  return NULL;
+}
+
+void create_team(size_t threads, bool pin)
+{
+  delete_team();
+
+  if (threads <= 1)
+    return;
+
+  team.workers = malloc((threads - 1) * sizeof(pthread_t));
+
+  if (team.workers == NULL)
+  {
+    fprintf(stderr,
+            "%s Cannot allocate memory\n"
+            "%s Terminating process...\n",
+            __ERROR__,
+            __RESULT__);
+    exit(EXIT_FAILURE);
+  }
+
+  /*
+   * Workers start with seen = 0: a generation left over from a previous team would
+   * wake them for a loop that never counted them in running.
+   */
+  pthread_mutex_lock(&team.lock);
+  team.stop = false;
+  team.generation = 0;
+  team.running = 0;
+  pthread_mutex_unlock(&team.lock);
+
+  team.size = 1;
+
+  /* Workers inherit this mask, and pin_thread spreads over it: save it before the caller is pinned */
+  if (pin == true)
+  {
+    team.caller = pthread_self();
+    team.pinned = pthread_getaffinity_np(team.caller, sizeof(team.caller_affinity), &team.caller_affinity) == 0;
+  }
+
+  for (size_t i = 1; i != threads; ++i)
+  {
+    if (pthread_create(team.workers + i - 1, NULL, worker_main, (void*)i) != 0)
+      break;
+
+    if (pin == true)
+      pin_thread(team.workers[i - 1], i);
+
+    ++team.size;
+  }
+
+  if (team.pinned == true)
+    pin_thread(team.caller, 0);
+}
+
+void delete_team(void)
+{
+  /* The caller was pinned as member 0, give it back the affinity it had before create_team */
+  if (team.pinned == true)
+  {
+    pthread_setaffinity_np(team.caller, sizeof(team.caller_affinity), &team.caller_affinity);
+    team.pinned = false;
+  }
+
+  if (team.workers == NULL)
+    return;
+
+  pthread_mutex_lock(&team.lock);
+  team.stop = true;
+  pthread_cond_broadcast(&team.start);
+  pthread_mutex_unlock(&team.lock);
+
+  for (size_t i = 0; i + 1 < team.size; ++i)
+    pthread_join(team.workers[i], NULL);
+
+  free(team.workers);
+  team.workers = NULL;
+  team.size = 1;
+}
+
+size_t team_size(void)
+{
+  return team.size;
+}
+
+void team_parallel_for(size_t count, size_t grain, team_task task, void* context)
+{
+  if (grain == 0)
+    grain = 1;
+
+  if (team.size == 1 || in_team == true || count <= grain)
+  {
+    if (count != 0)
+      task(context, 0, count, 0);
+    return;
+  }
+
+  pthread_mutex_lock(&team.lock);
+  team.task = task;
+  team.context = context;
+  team.count = count;
+  team.grain = grain;
+  atomic_store_explicit(&team.next, 0, memory_order_relaxed);
+  team.running = team.size - 1;
+  ++team.generation;
+  pthread_cond_broadcast(&team.start);
+  pthread_mutex_unlock(&team.lock);
+
+  in_team = true;
+  run_chunks(0);
+  in_team = false;
+
+  pthread_mutex_lock(&team.lock);
+
+  while (team.running != 0)
+    pthread_cond_wait(&team.done, &team.lock);
+
+  pthread_mutex_unlock(&team.lock);
+}